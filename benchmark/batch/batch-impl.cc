@@ -0,0 +1,9 @@
+#include "batch-impl.h"
+
+double BatchBenchmark::scale(double value, double factor) {
+  return value * factor;
+}
+
+uint32_t BatchBenchmark::length(const DOMString& text) {
+  return static_cast<uint32_t>(text.size());
+}
@@ -0,0 +1,12 @@
+#ifndef WEBIDL_NAPI_BENCHMARK_BATCH_BATCH_IMPL_H
+#define WEBIDL_NAPI_BENCHMARK_BATCH_BATCH_IMPL_H
+
+#include "webidl-napi.h"
+
+class BatchBenchmark {
+ public:
+  double scale(double value, double factor);
+  uint32_t length(const DOMString& text);
+};
+
+#endif  // WEBIDL_NAPI_BENCHMARK_BATCH_BATCH_IMPL_H
@@ -0,0 +1,46 @@
+'use strict';
+// Compares issuing many small calls one at a time with issuing them as a
+// batch, either as an array of argument arrays or as typed arrays.
+const binding =
+  require('bindings')({ bindings: 'batch', module_root: __dirname });
+const itemCount = 10000;
+const iterations = 100;
+
+function timeCalls(fn) {
+  // Warm up before measuring.
+  for (let idx = 0; idx < 10; idx++) fn();
+  const start = process.hrtime.bigint();
+  for (let idx = 0; idx < iterations; idx++) fn();
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+const bench = new binding.BatchBenchmark();
+const values = Float64Array.from({ length: itemCount }, (_, idx) => idx);
+const factors = new Float64Array(itemCount).fill(1.5);
+const numberRows = Array.from(values, (value, idx) => [ value, factors[idx] ]);
+const texts = Array.from({ length: itemCount }, (_, idx) => `text ${idx}`);
+const textRows = texts.map((text) => [ text ]);
+
+const results = [
+  [ 'scale() per item', () => {
+    for (let idx = 0; idx < itemCount; idx++) {
+      bench.scale(values[idx], factors[idx]);
+    }
+  } ],
+  [ 'scaleBatch() rows', () => bench.scaleBatch(numberRows) ],
+  [ 'scaleBatch() typed arrays', () => bench.scaleBatch(values, factors) ],
+  [ 'length() per item', () => {
+    for (let idx = 0; idx < itemCount; idx++) bench.length(texts[idx]);
+  } ],
+  [ 'lengthBatch() rows', () => bench.lengthBatch(textRows) ]
+].map(([ calls, fn ]) => {
+  const perBatch = timeCalls(fn);
+  return {
+    calls,
+    'per batch (us)': perBatch / 1000,
+    'per item (ns)': perBatch / itemCount
+  };
+});
+
+console.log(`[Batch] operations with ${itemCount} items`);
+console.table(results);
@@ -0,0 +1,20 @@
+'use strict';
+const { spawnSync } = require('child_process');
+const { readdirSync, lstatSync } = require('fs');
+const path = require('path');
+const repoRoot = require('bindings').getRoot('.');
+const cmakeJs = path.join(repoRoot, 'node_modules', '.bin', 'cmake-js');
+
+readdirSync(__dirname).forEach((item) => {
+  const benchDir = path.join(__dirname, item);
+  if (lstatSync(benchDir).isDirectory()) {
+    const child = spawnSync(cmakeJs, ['compile'], {
+      cwd: benchDir,
+      stdio: 'inherit',
+      shell: true
+    });
+    if (child.signal || child.status != 0) {
+      process.exit(1);
+    }
+  }
+});
@@ -0,0 +1,34 @@
+'use strict';
+// Compares returning a sequence of dictionaries as one object per item with
+// returning it as one typed array per member.
+const binding =
+  require('bindings')({ bindings: 'columnar', module_root: __dirname });
+const iterations = 20;
+
+function timeCalls(fn) {
+  // Warm up before measuring.
+  for (let idx = 0; idx < 3; idx++) fn();
+  const start = process.hrtime.bigint();
+  for (let idx = 0; idx < iterations; idx++) fn();
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+const bench = new binding.ColumnarBenchmark();
+const results = [];
+for (const count of [ 1000, 100000, 1000000 ]) {
+  for (const [ form, fn ] of [
+    [ 'sequence<Row>', () => bench.rows(count) ],
+    [ '[Columnar] sequence<Sample>', () => bench.columns(count) ]
+  ]) {
+    const perCall = timeCalls(fn);
+    results.push({
+      form,
+      items: count,
+      'per call (ms)': perCall / 1e6,
+      'per item (ns)': perCall / count
+    });
+  }
+}
+
+console.log('Returning sequences of dictionaries');
+console.table(results);
@@ -0,0 +1,21 @@
+#include "columnar-impl.h"
+
+WebIdlNapi::sequence<Row> ColumnarBenchmark::rows(unsigned long count) {
+  WebIdlNapi::sequence<Row> result;
+  result.resize(count);
+  for (unsigned long idx = 0; idx < count; idx++)
+    result[idx] = { idx * 0.5, idx * 2.0 };
+  return result;
+}
+
+WebIdlNapi::ColumnarSequence<Sample>
+ColumnarBenchmark::columns(unsigned long count) {
+  WebIdlNapi::ColumnarSequence<Sample> result(count);
+  double* times = result.Column(&Sample::time);
+  double* values = result.Column(&Sample::value);
+  for (unsigned long idx = 0; idx < count; idx++) {
+    times[idx] = idx * 0.5;
+    values[idx] = idx * 2.0;
+  }
+  return result;
+}
@@ -0,0 +1,22 @@
+#ifndef WEBIDL_NAPI_BENCHMARK_COLUMNAR_COLUMNAR_IMPL_H
+#define WEBIDL_NAPI_BENCHMARK_COLUMNAR_COLUMNAR_IMPL_H
+
+#include "webidl-napi.h"
+
+struct Row {
+  double time;
+  double value;
+};
+
+struct Sample {
+  double time;
+  double value;
+};
+
+class ColumnarBenchmark {
+ public:
+  WebIdlNapi::sequence<Row> rows(unsigned long count);
+  WebIdlNapi::ColumnarSequence<Sample> columns(unsigned long count);
+};
+
+#endif  // WEBIDL_NAPI_BENCHMARK_COLUMNAR_COLUMNAR_IMPL_H
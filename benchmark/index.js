@@ -0,0 +1,18 @@
+'use strict';
+const { spawnSync } = require('child_process');
+const { readdirSync, lstatSync } = require('fs');
+const path = require('path');
+
+readdirSync(__dirname).forEach((item) => {
+  const benchDir = path.join(__dirname, item);
+  if (lstatSync(benchDir).isDirectory()) {
+    const child = spawnSync(process.execPath, [
+      path.join(benchDir, 'bench.js')
+    ], {
+      stdio: 'inherit'
+    });
+    if (child.signal || child.status != 0) {
+      process.exit(1);
+    }
+  }
+});
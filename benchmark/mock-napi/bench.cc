@@ -0,0 +1,318 @@
+// Measures the conversion layer of the runtime against the stand-in N-API
+// implementation in mock-napi.cc, so that the numbers reflect the C++ work the
+// runtime does (allocations, copies, branches) rather than the engine.
+//
+// Usage: mock-napi [--iterations=N] [filter]
+//
+// Runs the benchmarks whose name contains `filter`, each for its default
+// number of iterations or for `N` iterations if given.
+#include "mock-napi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#define CHECK(the_call)                                                  \
+  do {                                                                   \
+    if ((the_call) != napi_ok) {                                         \
+      fprintf(stderr, "%s:%d: %s failed\n",                             \
+              __FILE__, __LINE__, #the_call);                            \
+      abort();                                                           \
+    }                                                                    \
+  } while (0)
+
+namespace {
+
+class Calculator {
+ public:
+  double add(double left, double right) { return left + right; }
+};
+
+// Runs `body` `iterations` times, each time in its own handle scope the way a
+// binding call runs in its own scope, and returns the time that took.
+template <typename Body>
+uint64_t TimeLoop(napi_env env, size_t iterations, Body body) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t idx = 0; idx < iterations; idx++) {
+    napi_handle_scope scope;
+    CHECK(napi_open_handle_scope(env, &scope));
+    body();
+    CHECK(napi_close_handle_scope(env, scope));
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+napi_value NumberArray(napi_env env, size_t length) {
+  napi_value result;
+  CHECK(napi_create_array_with_length(env, length, &result));
+  for (size_t idx = 0; idx < length; idx++) {
+    napi_value item;
+    CHECK(napi_create_double(env, idx * 0.5, &item));
+    CHECK(napi_set_element(env, result, idx, item));
+  }
+  return result;
+}
+
+napi_value StringArray(napi_env env, size_t length) {
+  napi_value result;
+  CHECK(napi_create_array_with_length(env, length, &result));
+  for (size_t idx = 0; idx < length; idx++) {
+    napi_value item;
+    std::string str = "item" + std::to_string(idx);
+    CHECK(napi_create_string_utf8(env, str.c_str(), str.size(), &item));
+    CHECK(napi_set_element(env, result, idx, item));
+  }
+  return result;
+}
+
+napi_value NumberRecord(napi_env env, size_t length) {
+  napi_value result;
+  CHECK(napi_create_object(env, &result));
+  for (size_t idx = 0; idx < length; idx++) {
+    napi_value item;
+    CHECK(napi_create_double(env, idx, &item));
+    CHECK(napi_set_named_property(env,
+                                  result,
+                                  ("key" + std::to_string(idx)).c_str(),
+                                  item));
+  }
+  return result;
+}
+
+const size_t kSequenceLength = 1024;
+const size_t kRecordLength = 64;
+
+uint64_t DoubleToNative(napi_env env, size_t iterations) {
+  napi_value js_value;
+  CHECK(napi_create_double(env, 42.5, &js_value));
+  double result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::Converter<double>::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t DoubleToJS(napi_env env, size_t iterations) {
+  napi_value result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::Converter<double>::ToJS(env, 42.5, &result));
+  });
+}
+
+uint64_t Uint32ToNative(napi_env env, size_t iterations) {
+  napi_value js_value;
+  CHECK(napi_create_uint32(env, 42, &js_value));
+  uint32_t result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::Converter<uint32_t>::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t DOMStringToNative(napi_env env, size_t iterations) {
+  napi_value js_value;
+  CHECK(napi_create_string_utf8(env, "hello, world", NAPI_AUTO_LENGTH,
+                                &js_value));
+  return TimeLoop(env, iterations, [&]() {
+    DOMString result;
+    CHECK(WebIdlNapi::Converter<DOMString>::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t DOMStringToJS(napi_env env, size_t iterations) {
+  DOMString value("hello, world");
+  napi_value result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::Converter<DOMString>::ToJS(env, value, &result));
+  });
+}
+
+uint64_t DoubleSequenceToNative(napi_env env, size_t iterations) {
+  napi_value js_value = NumberArray(env, kSequenceLength);
+  return TimeLoop(env, iterations, [&]() {
+    WebIdlNapi::sequence<double> result;
+    CHECK(WebIdlNapi::sequence<double>::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t DoubleSequenceToJS(napi_env env, size_t iterations) {
+  WebIdlNapi::sequence<double> value;
+  for (size_t idx = 0; idx < kSequenceLength; idx++)
+    value.push_back(idx * 0.5);
+  napi_value result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::sequence<double>::ToJS(env, value, &result));
+  });
+}
+
+uint64_t DOMStringSequenceToNative(napi_env env, size_t iterations) {
+  napi_value js_value = StringArray(env, kSequenceLength);
+  return TimeLoop(env, iterations, [&]() {
+    WebIdlNapi::sequence<DOMString> result;
+    CHECK(WebIdlNapi::sequence<DOMString>::ToNative(env, js_value, &result));
+  });
+}
+
+// The view converters run within an `ArenaScope` the way they do in a binding
+// call.
+uint64_t StringViewToNative(napi_env env, size_t iterations) {
+  napi_value js_value;
+  CHECK(napi_create_string_utf8(env, "hello, world", NAPI_AUTO_LENGTH,
+                                &js_value));
+  return TimeLoop(env, iterations, [&]() {
+    WebIdlNapi::ArenaScope arena_scope(env);
+    WebIdlNapi::StringView result;
+    CHECK(WebIdlNapi::Converter<WebIdlNapi::StringView>::ToNative(env,
+                                                                 js_value,
+                                                                 &result));
+  });
+}
+
+uint64_t DoubleSequenceViewToNative(napi_env env, size_t iterations) {
+  typedef WebIdlNapi::SequenceView<double> View;
+  napi_value js_value = NumberArray(env, kSequenceLength);
+  return TimeLoop(env, iterations, [&]() {
+    WebIdlNapi::ArenaScope arena_scope(env);
+    View result;
+    CHECK(View::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t StringViewSequenceViewToNative(napi_env env, size_t iterations) {
+  typedef WebIdlNapi::SequenceView<WebIdlNapi::StringView> View;
+  napi_value js_value = StringArray(env, kSequenceLength);
+  return TimeLoop(env, iterations, [&]() {
+    WebIdlNapi::ArenaScope arena_scope(env);
+    View result;
+    CHECK(View::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t RecordToNative(napi_env env, size_t iterations) {
+  typedef WebIdlNapi::record<DOMString, double> Record;
+  napi_value js_value = NumberRecord(env, kRecordLength);
+  return TimeLoop(env, iterations, [&]() {
+    Record result;
+    CHECK(Record::ToNative(env, js_value, &result));
+  });
+}
+
+uint64_t RecordToJS(napi_env env, size_t iterations) {
+  typedef WebIdlNapi::record<DOMString, double> Record;
+  Record value;
+  for (size_t idx = 0; idx < kRecordLength; idx++)
+    value.emplace_back("key" + std::to_string(idx), idx);
+  napi_value result;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(Record::ToJS(env, value, &result));
+  });
+}
+
+// Picks the last of three signatures, passing the candidates the way the
+// generated code does.
+uint64_t PickSignature(napi_env env, size_t iterations) {
+  static const napi_valuetype sig_0_types[] = { napi_number };
+  static const napi_valuetype sig_1_types[] = { napi_number, napi_number };
+  static const napi_valuetype sig_2_types[] = { napi_string, napi_object };
+  static const WebIdlNapi::SignatureCandidate sigs[] = {
+    { 1, sig_0_types },
+    { 2, sig_1_types },
+    { 2, sig_2_types }
+  };
+  napi_value argv[2];
+  CHECK(napi_create_string_utf8(env, "key", NAPI_AUTO_LENGTH, &argv[0]));
+  CHECK(napi_create_object(env, &argv[1]));
+  int sig_idx;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::PickSignature(env, 2, argv, sigs, 3, &sig_idx));
+  });
+}
+
+uint64_t WrappingRetrieve(napi_env env, size_t iterations) {
+  napi_value js_rcv;
+  CHECK(napi_create_object(env, &js_rcv));
+  CHECK(WebIdlNapi::Wrapping<Calculator>::Create(env,
+                                                 js_rcv,
+                                                 new Calculator));
+  Calculator* cc_rcv;
+  return TimeLoop(env, iterations, [&]() {
+    CHECK(WebIdlNapi::Wrapping<Calculator>::Retrieve(env, js_rcv, &cc_rcv));
+  });
+}
+
+// A complete call into a binding generated for `double add(double, double)`.
+uint64_t MethodCall(napi_env env, size_t iterations) {
+  napi_value js_rcv;
+  napi_value argv[2];
+  CHECK(napi_create_object(env, &js_rcv));
+  CHECK(WebIdlNapi::Wrapping<Calculator>::Create(env,
+                                                 js_rcv,
+                                                 new Calculator));
+  CHECK(napi_create_double(env, 1.5, &argv[0]));
+  CHECK(napi_create_double(env, 2.5, &argv[1]));
+  napi_callback_info__ info = { js_rcv, nullptr, 2, argv, nullptr };
+  return TimeLoop(env, iterations, [&]() {
+    if (WebIdlNapi::Method<decltype(&Calculator::add), &Calculator::add>::Call(
+            env, &info) == nullptr)
+      abort();
+  });
+}
+
+struct Benchmark {
+  const char* name;
+  // Items converted per iteration.
+  size_t items;
+  size_t iterations;
+  uint64_t (*run)(napi_env env, size_t iterations);
+};
+
+const Benchmark benchmarks[] = {
+  { "Converter<double>::ToNative", 1, 2000000, DoubleToNative },
+  { "Converter<double>::ToJS", 1, 2000000, DoubleToJS },
+  { "Converter<uint32_t>::ToNative", 1, 2000000, Uint32ToNative },
+  { "Converter<DOMString>::ToNative", 1, 1000000, DOMStringToNative },
+  { "Converter<DOMString>::ToJS", 1, 1000000, DOMStringToJS },
+  { "sequence<double>::ToNative", kSequenceLength, 2000,
+    DoubleSequenceToNative },
+  { "sequence<double>::ToJS", kSequenceLength, 2000, DoubleSequenceToJS },
+  { "sequence<DOMString>::ToNative", kSequenceLength, 1000,
+    DOMStringSequenceToNative },
+  { "Converter<StringView>::ToNative", 1, 1000000, StringViewToNative },
+  { "SequenceView<double>::ToNative", kSequenceLength, 2000,
+    DoubleSequenceViewToNative },
+  { "SequenceView<StringView>::ToNative", kSequenceLength, 1000,
+    StringViewSequenceViewToNative },
+  { "record<DOMString, double>::ToNative", kRecordLength, 10000,
+    RecordToNative },
+  { "record<DOMString, double>::ToJS", kRecordLength, 10000, RecordToJS },
+  { "PickSignature", 1, 1000000, PickSignature },
+  { "Wrapping<T>::Retrieve", 1, 2000000, WrappingRetrieve },
+  { "Method<add>::Call", 1, 1000000, MethodCall },
+};
+
+}  // end of anonymous namespace
+
+int main(int argc, char** argv) {
+  size_t iterations = 0;
+  const char* filter = "";
+  for (int idx = 1; idx < argc; idx++) {
+    if (strncmp(argv[idx], "--iterations=", 13) == 0) {
+      iterations = strtoul(argv[idx] + 13, nullptr, 10);
+    } else {
+      filter = argv[idx];
+    }
+  }
+
+  printf("%-38s %12s %12s %12s\n",
+         "benchmark", "iterations", "ns/op", "ns/item");
+  for (const Benchmark& bench : benchmarks) {
+    if (strstr(bench.name, filter) == nullptr) continue;
+    size_t count = iterations > 0 ? iterations : bench.iterations;
+    napi_env env = MockNapiCreateEnv();
+    double per_op = static_cast<double>(bench.run(env, count)) / count;
+    if (MockNapiTakeException(env, nullptr)) abort();
+    MockNapiDestroyEnv(env);
+    printf("%-38s %12zu %12.1f %12.2f\n",
+           bench.name, count, per_op, per_op / bench.items);
+  }
+  return 0;
+}
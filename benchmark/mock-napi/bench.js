@@ -0,0 +1,24 @@
+'use strict';
+// Runs the converter microbenchmarks built from bench.cc. Arguments are passed
+// on, so `node benchmark/mock-napi/bench.js --iterations=1000 sequence` runs
+// only the sequence benchmarks, each for 1000 iterations.
+const { spawnSync } = require('child_process');
+const { existsSync } = require('fs');
+const path = require('path');
+const executable =
+  'mock-napi' + (process.platform === 'win32' ? '.exe' : '');
+
+// cmake-js places the executable in build/Release with some generators and in
+// build/ with others.
+const candidates = [
+  path.join(__dirname, 'build', 'Release', executable),
+  path.join(__dirname, 'build', executable)
+];
+const found = candidates.find((candidate) => existsSync(candidate));
+if (!found) {
+  console.error(`${executable} not found. Run \`npm run prebenchmark\` first.`);
+  process.exit(1);
+}
+
+const child = spawnSync(found, process.argv.slice(2), { stdio: 'inherit' });
+process.exit(child.signal ? 1 : child.status);
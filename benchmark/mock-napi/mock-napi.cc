@@ -0,0 +1,831 @@
+#include "mock-napi.h"
+
+#include <math.h>
+#include <algorithm>
+#include <memory>
+
+namespace mock {
+
+struct Object;
+
+}  // end of namespace mock
+
+// Unlike in an engine, a value is a plain struct. Handles point into the
+// handle stack of the environment, and arrays and objects hold their elements
+// and properties by value.
+struct napi_value__ {
+  napi_valuetype type = napi_undefined;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  // Objects, arrays, typed arrays, functions, and externals.
+  std::shared_ptr<mock::Object> object;
+};
+
+namespace mock {
+
+struct Property {
+  std::string name;
+  napi_value__ value;
+  bool enumerable;
+};
+
+struct Object {
+  ~Object();
+  napi_env env = nullptr;
+  bool is_array = false;
+  std::vector<napi_value__> elements;
+  std::vector<Property> properties;
+  // Array buffers and typed arrays share the bytes of the buffer.
+  std::shared_ptr<std::vector<uint8_t>> buffer;
+  bool is_typedarray = false;
+  napi_typedarray_type typedarray_type = napi_uint8_array;
+  size_t byte_offset = 0;
+  size_t length = 0;
+  // Externals and functions.
+  void* data = nullptr;
+  napi_callback callback = nullptr;
+  // Wrapped native instances.
+  void* wrapped = nullptr;
+  napi_finalize wrap_finalize = nullptr;
+  void* wrap_hint = nullptr;
+};
+
+Object::~Object() {
+  if (wrap_finalize != nullptr) wrap_finalize(env, wrapped, wrap_hint);
+}
+
+// Handles are allocated in blocks which are kept when a scope closes, so that
+// opening and closing scopes does not allocate once the stack has grown to its
+// working size.
+const size_t kHandleBlockSize = 1024;
+const size_t kMaxScopeDepth = 256;
+
+}  // end of namespace mock
+
+struct napi_handle_scope__ {
+  size_t mark;
+};
+
+struct napi_escapable_handle_scope__ : public napi_handle_scope__ {
+  napi_value escape_slot;
+  bool escaped;
+};
+
+struct napi_ref__ {
+  napi_value__ value;
+  uint32_t count;
+};
+
+struct napi_deferred__ {
+  std::shared_ptr<mock::Object> promise;
+};
+
+struct napi_env__ {
+  std::vector<std::unique_ptr<napi_value__[]>> handle_blocks;
+  size_t handle_count = 0;
+  napi_escapable_handle_scope__ scopes[mock::kMaxScopeDepth];
+  size_t scope_depth = 0;
+  napi_value__ undefined;
+  napi_value__ null;
+  napi_value__ true_value;
+  napi_value__ false_value;
+  napi_extended_error_info last_error = { nullptr, nullptr, 0, napi_ok };
+  bool exception_pending = false;
+  std::string exception_message;
+  void* instance_data = nullptr;
+  napi_finalize instance_data_finalize = nullptr;
+  void* instance_data_hint = nullptr;
+};
+
+namespace mock {
+
+static const char* StatusMessage(napi_status status) {
+  switch (status) {
+    case napi_ok: return nullptr;
+    case napi_invalid_arg: return "Invalid argument";
+    case napi_object_expected: return "An object was expected";
+    case napi_string_expected: return "A string was expected";
+    case napi_function_expected: return "A function was expected";
+    case napi_number_expected: return "A number was expected";
+    case napi_boolean_expected: return "A boolean was expected";
+    case napi_array_expected: return "An array was expected";
+    case napi_escape_called_twice:
+      return "napi_escape_handle already called on scope";
+    case napi_handle_scope_mismatch:
+      return "Invalid handle scope usage";
+    default: return "Unknown failure";
+  }
+}
+
+static napi_status SetStatus(napi_env env, napi_status status) {
+  env->last_error.error_code = status;
+  env->last_error.error_message = StatusMessage(status);
+  return status;
+}
+
+static napi_value NewHandle(napi_env env) {
+  size_t block = env->handle_count / kHandleBlockSize;
+  if (block == env->handle_blocks.size())
+    env->handle_blocks.emplace_back(new napi_value__[kHandleBlockSize]);
+  return &env->handle_blocks[block][env->handle_count++ % kHandleBlockSize];
+}
+
+static napi_value NewHandle(napi_env env, const napi_value__& value) {
+  napi_value result = NewHandle(env);
+  *result = value;
+  return result;
+}
+
+static void UnwindHandles(napi_env env, size_t mark) {
+  while (env->handle_count > mark) {
+    env->handle_count--;
+    env->handle_blocks[env->handle_count / kHandleBlockSize]
+                      [env->handle_count % kHandleBlockSize] = napi_value__();
+  }
+}
+
+static napi_value NewObject(napi_env env, napi_valuetype type) {
+  napi_value result = NewHandle(env);
+  result->type = type;
+  result->object = std::make_shared<Object>();
+  result->object->env = env;
+  return result;
+}
+
+static napi_value NewNumber(napi_env env, double number, napi_value* result) {
+  *result = NewHandle(env);
+  (*result)->type = napi_number;
+  (*result)->number = number;
+  return *result;
+}
+
+static bool IsObject(napi_value value) {
+  return value->type == napi_object || value->type == napi_function;
+}
+
+static Property* FindProperty(Object* object, const std::string& name) {
+  for (auto& prop : object->properties)
+    if (prop.name == name) return &prop;
+  return nullptr;
+}
+
+static void SetProperty(Object* object,
+                        const std::string& name,
+                        const napi_value__& value,
+                        bool enumerable) {
+  Property* prop = FindProperty(object, name);
+  if (prop == nullptr) {
+    object->properties.push_back({ name, value, enumerable });
+  } else {
+    prop->value = value;
+  }
+}
+
+static size_t TypedArrayElementSize(napi_typedarray_type type) {
+  switch (type) {
+    case napi_int16_array:
+    case napi_uint16_array: return 2;
+    case napi_int32_array:
+    case napi_uint32_array:
+    case napi_float32_array: return 4;
+    case napi_float64_array:
+    case napi_bigint64_array:
+    case napi_biguint64_array: return 8;
+    default: return 1;
+  }
+}
+
+static double TypedArrayElement(Object* object, uint32_t index) {
+  const uint8_t* data = object->buffer->data() + object->byte_offset;
+  switch (object->typedarray_type) {
+    case napi_int8_array: return reinterpret_cast<const int8_t*>(data)[index];
+    case napi_int16_array: return reinterpret_cast<const int16_t*>(data)[index];
+    case napi_uint16_array:
+      return reinterpret_cast<const uint16_t*>(data)[index];
+    case napi_int32_array: return reinterpret_cast<const int32_t*>(data)[index];
+    case napi_uint32_array:
+      return reinterpret_cast<const uint32_t*>(data)[index];
+    case napi_float32_array:
+      return reinterpret_cast<const float*>(data)[index];
+    case napi_float64_array:
+      return reinterpret_cast<const double*>(data)[index];
+    default: return data[index];
+  }
+}
+
+// ECMAScript ToInt64 followed by truncation, which is what ToInt32 and
+// ToUint32 reduce to for the values benchmarks use.
+static int64_t ToInteger(double number) {
+  if (!isfinite(number) || fabs(number) >= 9223372036854775808.0) return 0;
+  return static_cast<int64_t>(number);
+}
+
+}  // end of namespace mock
+
+using mock::NewHandle;
+using mock::SetStatus;
+
+napi_env MockNapiCreateEnv() {
+  napi_env env = new napi_env__;
+  env->null.type = napi_null;
+  env->true_value.type = napi_boolean;
+  env->true_value.boolean = true;
+  env->false_value.type = napi_boolean;
+  return env;
+}
+
+void MockNapiDestroyEnv(napi_env env) {
+  mock::UnwindHandles(env, 0);
+  if (env->instance_data_finalize != nullptr)
+    env->instance_data_finalize(env,
+                                env->instance_data,
+                                env->instance_data_hint);
+  delete env;
+}
+
+bool MockNapiTakeException(napi_env env, std::string* message) {
+  bool was_pending = env->exception_pending;
+  if (message != nullptr) *message = env->exception_message;
+  env->exception_pending = false;
+  env->exception_message.clear();
+  return was_pending;
+}
+
+napi_status napi_get_last_error_info(napi_env env,
+                                     const napi_extended_error_info** result) {
+  *result = &env->last_error;
+  return napi_ok;
+}
+
+napi_status napi_is_exception_pending(napi_env env, bool* result) {
+  *result = env->exception_pending;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_throw_error(napi_env env, const char* code, const char* msg) {
+  (void) code;
+  env->exception_pending = true;
+  env->exception_message = msg;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_error(napi_env env,
+                              napi_value code,
+                              napi_value msg,
+                              napi_value* result) {
+  (void) code;
+  if (msg->type != napi_string) return SetStatus(env, napi_string_expected);
+  *result = mock::NewObject(env, napi_object);
+  mock::SetProperty((*result)->object.get(), "message", *msg, false);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_open_handle_scope(napi_env env, napi_handle_scope* result) {
+  if (env->scope_depth == mock::kMaxScopeDepth)
+    return SetStatus(env, napi_generic_failure);
+  napi_escapable_handle_scope__* scope = &env->scopes[env->scope_depth++];
+  scope->mark = env->handle_count;
+  *result = scope;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_close_handle_scope(napi_env env, napi_handle_scope scope) {
+  if (env->scope_depth == 0 || scope != &env->scopes[env->scope_depth - 1])
+    return SetStatus(env, napi_handle_scope_mismatch);
+  mock::UnwindHandles(env, scope->mark);
+  env->scope_depth--;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status
+napi_open_escapable_handle_scope(napi_env env,
+                                 napi_escapable_handle_scope* result) {
+  if (env->scope_depth == mock::kMaxScopeDepth)
+    return SetStatus(env, napi_generic_failure);
+  // The slot for the escaped value belongs to the enclosing scope.
+  napi_value escape_slot = NewHandle(env);
+  napi_escapable_handle_scope__* scope = &env->scopes[env->scope_depth++];
+  scope->mark = env->handle_count;
+  scope->escape_slot = escape_slot;
+  scope->escaped = false;
+  *result = scope;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status
+napi_close_escapable_handle_scope(napi_env env,
+                                  napi_escapable_handle_scope scope) {
+  return napi_close_handle_scope(env, scope);
+}
+
+napi_status napi_escape_handle(napi_env env,
+                               napi_escapable_handle_scope scope,
+                               napi_value escapee,
+                               napi_value* result) {
+  if (scope->escaped) return SetStatus(env, napi_escape_called_twice);
+  scope->escaped = true;
+  *scope->escape_slot = *escapee;
+  *result = scope->escape_slot;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value* result) {
+  *result = &env->undefined;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_null(napi_env env, napi_value* result) {
+  *result = &env->null;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value* result) {
+  *result = value ? &env->true_value : &env->false_value;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_object(napi_env env, napi_value* result) {
+  *result = mock::NewObject(env, napi_object);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_array(napi_env env, napi_value* result) {
+  *result = mock::NewObject(env, napi_object);
+  (*result)->object->is_array = true;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_array_with_length(napi_env env,
+                                          size_t length,
+                                          napi_value* result) {
+  *result = mock::NewObject(env, napi_object);
+  (*result)->object->is_array = true;
+  (*result)->object->elements.resize(length);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_double(napi_env env, double value, napi_value* result) {
+  mock::NewNumber(env, value, result);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value* result) {
+  mock::NewNumber(env, value, result);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_uint32(napi_env env,
+                               uint32_t value,
+                               napi_value* result) {
+  mock::NewNumber(env, value, result);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_int64(napi_env env, int64_t value, napi_value* result) {
+  mock::NewNumber(env, static_cast<double>(value), result);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_string_utf8(napi_env env,
+                                    const char* str,
+                                    size_t length,
+                                    napi_value* result) {
+  if (length == NAPI_AUTO_LENGTH) length = strlen(str);
+  *result = NewHandle(env);
+  (*result)->type = napi_string;
+  (*result)->string.assign(str, length);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_create_arraybuffer(napi_env env,
+                                    size_t byte_length,
+                                    void** data,
+                                    napi_value* result) {
+  *result = mock::NewObject(env, napi_object);
+  (*result)->object->buffer =
+      std::make_shared<std::vector<uint8_t>>(byte_length);
+  (*result)->object->length = byte_length;
+  if (data != nullptr) *data = (*result)->object->buffer->data();
+  return SetStatus(env, napi_ok);
+}
+
+// Array buffers own their bytes here, so external ones are refused, the way a
+// runtime which does not allow them would.
+napi_status napi_create_external_arraybuffer(napi_env env,
+                                             void* external_data,
+                                             size_t byte_length,
+                                             napi_finalize finalize_cb,
+                                             void* finalize_hint,
+                                             napi_value* result) {
+  (void) external_data;
+  (void) byte_length;
+  (void) finalize_cb;
+  (void) finalize_hint;
+  (void) result;
+  return SetStatus(env, napi_no_external_buffers_allowed);
+}
+
+napi_status napi_create_typedarray(napi_env env,
+                                   napi_typedarray_type type,
+                                   size_t length,
+                                   napi_value arraybuffer,
+                                   size_t byte_offset,
+                                   napi_value* result) {
+  if (!mock::IsObject(arraybuffer) || !arraybuffer->object->buffer ||
+      arraybuffer->object->is_typedarray)
+    return SetStatus(env, napi_invalid_arg);
+  if (byte_offset + length * mock::TypedArrayElementSize(type) >
+      arraybuffer->object->buffer->size())
+    return SetStatus(env, napi_invalid_arg);
+  *result = mock::NewObject(env, napi_object);
+  mock::Object* array = (*result)->object.get();
+  array->buffer = arraybuffer->object->buffer;
+  array->is_typedarray = true;
+  array->typedarray_type = type;
+  array->byte_offset = byte_offset;
+  array->length = length;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_double(napi_env env,
+                                  napi_value value,
+                                  double* result) {
+  if (value->type != napi_number) return SetStatus(env, napi_number_expected);
+  *result = value->number;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_int32(napi_env env,
+                                 napi_value value,
+                                 int32_t* result) {
+  if (value->type != napi_number) return SetStatus(env, napi_number_expected);
+  *result = static_cast<int32_t>(mock::ToInteger(value->number));
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_uint32(napi_env env,
+                                  napi_value value,
+                                  uint32_t* result) {
+  if (value->type != napi_number) return SetStatus(env, napi_number_expected);
+  *result = static_cast<uint32_t>(mock::ToInteger(value->number));
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_int64(napi_env env,
+                                 napi_value value,
+                                 int64_t* result) {
+  if (value->type != napi_number) return SetStatus(env, napi_number_expected);
+  *result = mock::ToInteger(value->number);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool* result) {
+  if (value->type != napi_boolean) return SetStatus(env, napi_boolean_expected);
+  *result = value->boolean;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_value_string_utf8(napi_env env,
+                                       napi_value value,
+                                       char* buf,
+                                       size_t bufsize,
+                                       size_t* result) {
+  if (value->type != napi_string) return SetStatus(env, napi_string_expected);
+  if (buf == nullptr) {
+    *result = value->string.size();
+  } else if (bufsize > 0) {
+    size_t copied = std::min(value->string.size(), bufsize - 1);
+    memcpy(buf, value->string.data(), copied);
+    buf[copied] = 0;
+    if (result != nullptr) *result = copied;
+  } else if (result != nullptr) {
+    *result = 0;
+  }
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_typeof(napi_env env,
+                        napi_value value,
+                        napi_valuetype* result) {
+  *result = value->type;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool* result) {
+  *result = mock::IsObject(value) && value->object->is_array;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_array_length(napi_env env,
+                                  napi_value value,
+                                  uint32_t* result) {
+  if (!mock::IsObject(value) || !value->object->is_array)
+    return SetStatus(env, napi_array_expected);
+  *result = static_cast<uint32_t>(value->object->elements.size());
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_is_typedarray(napi_env env, napi_value value, bool* result) {
+  *result = mock::IsObject(value) && value->object->is_typedarray;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_typedarray_info(napi_env env,
+                                     napi_value typedarray,
+                                     napi_typedarray_type* type,
+                                     size_t* length,
+                                     void** data,
+                                     napi_value* arraybuffer,
+                                     size_t* byte_offset) {
+  if (!mock::IsObject(typedarray) || !typedarray->object->is_typedarray)
+    return SetStatus(env, napi_invalid_arg);
+  mock::Object* array = typedarray->object.get();
+  if (type != nullptr) *type = array->typedarray_type;
+  if (length != nullptr) *length = array->length;
+  if (data != nullptr) *data = array->buffer->data() + array->byte_offset;
+  if (arraybuffer != nullptr) {
+    *arraybuffer = mock::NewObject(env, napi_object);
+    (*arraybuffer)->object->buffer = array->buffer;
+    (*arraybuffer)->object->length = array->buffer->size();
+  }
+  if (byte_offset != nullptr) *byte_offset = array->byte_offset;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_element(napi_env env,
+                             napi_value object,
+                             uint32_t index,
+                             napi_value* result) {
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  mock::Object* obj = object->object.get();
+  if (obj->is_array) {
+    *result = index < obj->elements.size() ?
+        NewHandle(env, obj->elements[index]) : &env->undefined;
+  } else if (obj->is_typedarray) {
+    if (index < obj->length)
+      mock::NewNumber(env, mock::TypedArrayElement(obj, index), result);
+    else
+      *result = &env->undefined;
+  } else {
+    mock::Property* prop = mock::FindProperty(obj, std::to_string(index));
+    *result = prop == nullptr ? &env->undefined : NewHandle(env, prop->value);
+  }
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_set_element(napi_env env,
+                             napi_value object,
+                             uint32_t index,
+                             napi_value value) {
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  mock::Object* obj = object->object.get();
+  if (obj->is_array) {
+    if (index >= obj->elements.size()) obj->elements.resize(index + 1);
+    obj->elements[index] = *value;
+  } else {
+    mock::SetProperty(obj, std::to_string(index), *value, true);
+  }
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_named_property(napi_env env,
+                                    napi_value object,
+                                    const char* utf8name,
+                                    napi_value* result) {
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  mock::Object* obj = object->object.get();
+  if (obj->is_array && strcmp(utf8name, "length") == 0) {
+    mock::NewNumber(env, obj->elements.size(), result);
+  } else {
+    mock::Property* prop = mock::FindProperty(obj, utf8name);
+    *result = prop == nullptr ? &env->undefined : NewHandle(env, prop->value);
+  }
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_set_named_property(napi_env env,
+                                    napi_value object,
+                                    const char* utf8name,
+                                    napi_value value) {
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  mock::SetProperty(object->object.get(), utf8name, *value, true);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_property(napi_env env,
+                              napi_value object,
+                              napi_value key,
+                              napi_value* result) {
+  if (key->type == napi_number)
+    return napi_get_element(env,
+                            object,
+                            static_cast<uint32_t>(key->number),
+                            result);
+  if (key->type != napi_string) return SetStatus(env, napi_name_expected);
+  return napi_get_named_property(env, object, key->string.c_str(), result);
+}
+
+napi_status napi_set_property(napi_env env,
+                              napi_value object,
+                              napi_value key,
+                              napi_value value) {
+  if (key->type == napi_number)
+    return napi_set_element(env,
+                            object,
+                            static_cast<uint32_t>(key->number),
+                            value);
+  if (key->type != napi_string) return SetStatus(env, napi_name_expected);
+  return napi_set_named_property(env, object, key->string.c_str(), value);
+}
+
+napi_status napi_define_properties(napi_env env,
+                                   napi_value object,
+                                   size_t property_count,
+                                   const napi_property_descriptor* properties) {
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  for (size_t idx = 0; idx < property_count; idx++) {
+    const napi_property_descriptor& desc = properties[idx];
+    std::string name;
+    if (desc.utf8name != nullptr) {
+      name = desc.utf8name;
+    } else if (desc.name != nullptr && desc.name->type == napi_string) {
+      name = desc.name->string;
+    } else {
+      return SetStatus(env, napi_name_expected);
+    }
+
+    // Accessors are recorded as `undefined`, since nothing reads them back.
+    napi_value__ value;
+    if (desc.value != nullptr) {
+      value = *desc.value;
+    } else if (desc.method != nullptr) {
+      value.type = napi_function;
+      value.object = std::make_shared<mock::Object>();
+      value.object->env = env;
+      value.object->callback = desc.method;
+      value.object->data = desc.data;
+    }
+    mock::SetProperty(object->object.get(),
+                      name,
+                      value,
+                      (desc.attributes & napi_enumerable) != 0);
+  }
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_all_property_names(napi_env env,
+                                        napi_value object,
+                                        napi_key_collection_mode key_mode,
+                                        napi_key_filter key_filter,
+                                        napi_key_conversion key_conversion,
+                                        napi_value* result) {
+  (void) key_mode;
+  if (!mock::IsObject(object)) return SetStatus(env, napi_object_expected);
+  mock::Object* obj = object->object.get();
+  napi_value names;
+  napi_create_array(env, &names);
+  std::vector<napi_value__>& elements = names->object->elements;
+
+  // Array indices come first, in ascending order.
+  for (size_t idx = 0; idx < obj->elements.size(); idx++) {
+    napi_value__ name;
+    if (key_conversion == napi_key_numbers_to_strings) {
+      name.type = napi_string;
+      name.string = std::to_string(idx);
+    } else {
+      name.type = napi_number;
+      name.number = idx;
+    }
+    elements.push_back(name);
+  }
+
+  for (auto& prop : obj->properties) {
+    if ((key_filter & napi_key_enumerable) != 0 && !prop.enumerable) continue;
+    napi_value__ name;
+    name.type = napi_string;
+    name.string = prop.name;
+    elements.push_back(name);
+  }
+
+  *result = names;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_wrap(napi_env env,
+                      napi_value js_object,
+                      void* native_object,
+                      napi_finalize finalize_cb,
+                      void* finalize_hint,
+                      napi_ref* result) {
+  if (!mock::IsObject(js_object)) return SetStatus(env, napi_object_expected);
+  mock::Object* obj = js_object->object.get();
+  if (obj->wrapped != nullptr) return SetStatus(env, napi_invalid_arg);
+  obj->wrapped = native_object;
+  obj->wrap_finalize = finalize_cb;
+  obj->wrap_hint = finalize_hint;
+  if (result != nullptr) return napi_create_reference(env, js_object, 0, result);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_unwrap(napi_env env, napi_value js_object, void** result) {
+  if (!mock::IsObject(js_object)) return SetStatus(env, napi_object_expected);
+  if (js_object->object->wrapped == nullptr)
+    return SetStatus(env, napi_invalid_arg);
+  *result = js_object->object->wrapped;
+  return SetStatus(env, napi_ok);
+}
+
+// References are always strong, since nothing is ever collected.
+napi_status napi_create_reference(napi_env env,
+                                  napi_value value,
+                                  uint32_t initial_refcount,
+                                  napi_ref* result) {
+  *result = new napi_ref__{ *value, initial_refcount };
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_delete_reference(napi_env env, napi_ref ref) {
+  delete ref;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_reference_value(napi_env env,
+                                     napi_ref ref,
+                                     napi_value* result) {
+  *result = NewHandle(env, ref->value);
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_set_instance_data(napi_env env,
+                                   void* data,
+                                   napi_finalize finalize_cb,
+                                   void* finalize_hint) {
+  env->instance_data = data;
+  env->instance_data_finalize = finalize_cb;
+  env->instance_data_hint = finalize_hint;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_instance_data(napi_env env, void** data) {
+  *data = env->instance_data;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_cb_info(napi_env env,
+                             napi_callback_info cbinfo,
+                             size_t* argc,
+                             napi_value* argv,
+                             napi_value* this_arg,
+                             void** data) {
+  if (argv != nullptr) {
+    for (size_t idx = 0; idx < *argc; idx++)
+      argv[idx] = idx < cbinfo->argc ? cbinfo->argv[idx] : &env->undefined;
+  }
+  if (argc != nullptr) *argc = cbinfo->argc;
+  if (this_arg != nullptr) *this_arg = cbinfo->this_arg;
+  if (data != nullptr) *data = cbinfo->data;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_get_new_target(napi_env env,
+                                napi_callback_info cbinfo,
+                                napi_value* result) {
+  *result = cbinfo->new_target;
+  return SetStatus(env, napi_ok);
+}
+
+// A promise is an object whose `state` and `value` properties record how it
+// was concluded.
+napi_status napi_create_promise(napi_env env,
+                                napi_deferred* deferred,
+                                napi_value* promise) {
+  *promise = mock::NewObject(env, napi_object);
+  *deferred = new napi_deferred__{ (*promise)->object };
+  return SetStatus(env, napi_ok);
+}
+
+static napi_status ConcludeDeferred(napi_env env,
+                                    napi_deferred deferred,
+                                    const char* state,
+                                    napi_value value) {
+  napi_value__ state_value;
+  state_value.type = napi_string;
+  state_value.string = state;
+  mock::SetProperty(deferred->promise.get(), "state", state_value, true);
+  mock::SetProperty(deferred->promise.get(), "value", *value, true);
+  delete deferred;
+  return SetStatus(env, napi_ok);
+}
+
+napi_status napi_resolve_deferred(napi_env env,
+                                  napi_deferred deferred,
+                                  napi_value resolution) {
+  return ConcludeDeferred(env, deferred, "fulfilled", resolution);
+}
+
+napi_status napi_reject_deferred(napi_env env,
+                                 napi_deferred deferred,
+                                 napi_value rejection) {
+  return ConcludeDeferred(env, deferred, "rejected", rejection);
+}
@@ -0,0 +1,29 @@
+#ifndef MOCK_NAPI_H
+#define MOCK_NAPI_H
+
+#include "webidl-napi.h"
+
+// An in-process stand-in for the subset of `js_native_api.h` used by the
+// webidl-napi runtime. Values live on a handle stack which is unwound when a
+// handle scope closes, objects are reference-counted, and nothing is ever
+// collected, so runs are deterministic and cheap enough that a profile of the
+// benchmarks shows the conversion layer rather than the engine.
+
+// The `napi_callback_info` the bindings receive. Benchmarks fill one in on the
+// stack and pass it to a `napi_callback` directly.
+struct napi_callback_info__ {
+  napi_value this_arg;
+  napi_value new_target;
+  size_t argc;
+  napi_value* argv;
+  void* data;
+};
+
+napi_env MockNapiCreateEnv();
+void MockNapiDestroyEnv(napi_env env);
+
+// Whether a JS exception is pending in `env`. Clears it, and, if `message` is
+// not `nullptr`, stores its message there.
+bool MockNapiTakeException(napi_env env, std::string* message);
+
+#endif  // MOCK_NAPI_H
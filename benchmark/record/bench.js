@@ -0,0 +1,35 @@
+'use strict';
+// Measures the conversion of records with many keys, the shape of the
+// configuration payloads record<K, V> is meant for.
+const binding =
+  require('bindings')({ bindings: 'record', module_root: __dirname });
+const keyCount = 10000;
+const iterations = 200;
+
+function timeCalls(fn) {
+  // Warm up before measuring.
+  for (let idx = 0; idx < 10; idx++) fn();
+  const start = process.hrtime.bigint();
+  for (let idx = 0; idx < iterations; idx++) fn();
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+const bench = new binding.RecordBenchmark();
+const input = {};
+for (let idx = 0; idx < keyCount; idx++) input[`key${idx}`] = idx;
+
+const results = [
+  [ 'JS to native', () => bench.consume(input) ],
+  [ 'native to JS', () => bench.produce(keyCount) ],
+  [ 'round trip', () => bench.roundTrip(input) ]
+].map(([ conversion, fn ]) => {
+  const perCall = timeCalls(fn);
+  return {
+    conversion,
+    'per call (us)': perCall / 1000,
+    'per key (ns)': perCall / keyCount
+  };
+});
+
+console.log(`record<DOMString, unsigned long> with ${keyCount} keys`);
+console.table(results);
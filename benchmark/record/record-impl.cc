@@ -0,0 +1,24 @@
+#include "record-impl.h"
+
+unsigned long
+RecordBenchmark::consume(
+    const WebIdlNapi::record<DOMString, unsigned long>& input) {
+  return input.size();
+}
+
+const WebIdlNapi::record<DOMString, unsigned long>&
+RecordBenchmark::produce(unsigned long count) {
+  if (produced.size() != count) {
+    produced.clear();
+    produced.reserve(count);
+    for (unsigned long idx = 0; idx < count; idx++)
+      produced.emplace_back("key" + std::to_string(idx), idx);
+  }
+  return produced;
+}
+
+WebIdlNapi::record<DOMString, unsigned long>
+RecordBenchmark::roundTrip(
+    const WebIdlNapi::record<DOMString, unsigned long>& input) {
+  return input;
+}
@@ -0,0 +1,20 @@
+#ifndef WEBIDL_NAPI_BENCHMARK_RECORD_RECORD_IMPL_H
+#define WEBIDL_NAPI_BENCHMARK_RECORD_RECORD_IMPL_H
+
+#include "webidl-napi.h"
+
+class RecordBenchmark {
+ public:
+  unsigned long
+  consume(const WebIdlNapi::record<DOMString, unsigned long>& input);
+  const WebIdlNapi::record<DOMString, unsigned long>&
+  produce(unsigned long count);
+  WebIdlNapi::record<DOMString, unsigned long>
+  roundTrip(const WebIdlNapi::record<DOMString, unsigned long>& input);
+ private:
+  // `produce()` returns this record, so that only its conversion to JS is
+  // measured.
+  WebIdlNapi::record<DOMString, unsigned long> produced;
+};
+
+#endif  // WEBIDL_NAPI_BENCHMARK_RECORD_RECORD_IMPL_H
@@ -0,0 +1,86 @@
+'use strict';
+// Compares the add-on generated from the WebGPU test IDL in the default
+// (unrolled) mode with the one generated in compact (table-driven) mode with
+// respect to binary size, load time, and call latency.
+const { spawnSync } = require('child_process');
+const { statSync } = require('fs');
+const path = require('path');
+const modes = [ 'unrolled', 'compact' ];
+const loadRuns = 20;
+const iterations = 200000;
+
+function addonPath(mode) {
+  return path.join(__dirname, 'build', 'Release', `webgpu_${mode}.node`);
+}
+
+function median(values) {
+  const sorted = values.slice().sort((a, b) => (a - b));
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function timeCalls(fn) {
+  const start = process.hrtime.bigint();
+  for (let idx = 0; idx < iterations; idx++) fn();
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+// Runs in a child process so that each add-on is loaded into a fresh process.
+async function measure(mode) {
+  const start = process.hrtime.bigint();
+  const binding = require(addonPath(mode));
+  const loadTime = Number(process.hrtime.bigint() - start);
+
+  const gpu = new binding.GPU();
+  const adapter = await gpu.requestAdapter();
+  const nav = new binding.Navigator();
+  const descriptor = {
+    extensions: [ 'depth-clamping' ],
+    limits: {
+      maxBindGroups: 4,
+      maxDynamicUniformBuffersPerPipelineLayout: 8,
+      maxDynamicStorageBuffersPerPipelineLayout: 4,
+      maxSampledTexturesPerShaderStage: 16,
+      maxSamplersPerShaderStage: 16,
+      maxStorageBuffersPerShaderStage: 4,
+      maxStorageTexturesPerShaderStage: 4,
+      maxUniformBuffersPerShaderStage: 12,
+      maxUniformBufferBindingSize: 16384
+    }
+  };
+
+  console.log(JSON.stringify({
+    loadTime,
+    attribute: timeCalls(() => adapter.name),
+    sameObjectAttribute: timeCalls(() => nav.gpu),
+    dictionaryArgument: timeCalls(() => adapter.requestDevice(descriptor))
+  }));
+}
+
+if (process.argv[2]) {
+  measure(process.argv[2]);
+} else {
+  const results = modes.map((mode) => {
+    const runs = [];
+    for (let idx = 0; idx < loadRuns; idx++) {
+      const child = spawnSync(process.execPath, [ __filename, mode ], {
+        stdio: [ 'ignore', 'pipe', 'ignore' ]
+      });
+      if (child.signal || child.status != 0) {
+        throw new Error(`Benchmark for ${mode} mode failed`);
+      }
+      runs.push(JSON.parse(child.stdout.toString()));
+    }
+    return {
+      mode,
+      'size (bytes)': statSync(addonPath(mode)).size,
+      'load (us)': median(runs.map((run) => run.loadTime)) / 1000,
+      'attribute (ns)': median(runs.map((run) => run.attribute)),
+      '[SameObject] attribute (ns)':
+        median(runs.map((run) => run.sameObjectAttribute)),
+      'dictionary argument (ns)':
+        median(runs.map((run) => run.dictionaryArgument))
+    };
+  });
+  console.log('WebGPU test IDL: unrolled vs. compact code generation');
+  console.table(results);
+}
@@ -11,6 +11,13 @@ const argv = yargs
   .nargs('i', 1)
   .nargs('o', 1)
   .describe('o', 'output file')
+  .boolean('compact')
+  .describe('compact',
+    'describe dictionaries and attributes with tables instead of generating ' +
+    'code for each member, to reduce code size')
+  .boolean('trace')
+  .describe('trace',
+    'record the begin and end of each binding call into a trace buffer')
   .argv;
 
 if (argv._.length === 0) {
@@ -52,7 +59,47 @@ const typemapWebIDLBasicTypesToNAPI = {
   'USVString': { type: 'napi_string', converter: 'USVString' },
 
   // object
-  'object': { type: 'napi_object', converter: 'object' }
+  'object': { type: 'napi_object', converter: 'object' },
+
+  // bigint, for `long long` and `unsigned long long` marked `[BigInt]`
+  'WebIdlNapi::bigint64_t': {
+    type: 'napi_bigint',
+    converter: 'WebIdlNapi::bigint64'
+  },
+  'WebIdlNapi::biguint64_t': {
+    type: 'napi_bigint',
+    converter: 'WebIdlNapi::biguint64'
+  }
+};
+
+// The native types of `long long` and `unsigned long long` values marked
+// `[BigInt]`, which convert to and from BigInts rather than numbers.
+const bigIntNativeTypes = {
+  'long long': 'WebIdlNapi::bigint64_t',
+  'unsigned long long': 'WebIdlNapi::biguint64_t'
+};
+
+// The typed array which holds a column of a `[Columnar]` dictionary member in
+// JS, and the type of its elements, by the native type generated for the IDL
+// type of the member. 64-bit integers are numbers unless marked `[BigInt]`.
+const columnTypedArrays = {
+  'byte': { type: 'napi_int8_array', element: 'int8_t' },
+  'octet': { type: 'napi_uint8_array', element: 'uint8_t' },
+  'short': { type: 'napi_int16_array', element: 'int16_t' },
+  'unsigned short': { type: 'napi_uint16_array', element: 'uint16_t' },
+  'long': { type: 'napi_int32_array', element: 'int32_t' },
+  'unsigned long': { type: 'napi_uint32_array', element: 'uint32_t' },
+  'long long': { type: 'napi_float64_array', element: 'double' },
+  'unsigned long long': { type: 'napi_float64_array', element: 'double' },
+  'float': { type: 'napi_float32_array', element: 'float' },
+  'unrestricted float': { type: 'napi_float32_array', element: 'float' },
+  'double': { type: 'napi_float64_array', element: 'double' },
+  'unrestricted double': { type: 'napi_float64_array', element: 'double' },
+  'WebIdlNapi::bigint64_t': { type: 'napi_bigint64_array', element: 'int64_t' },
+  'WebIdlNapi::biguint64_t': {
+    type: 'napi_biguint64_array',
+    element: 'uint64_t'
+  }
 };
 
 function generateForwardDeclaration(decl) {
@@ -109,11 +156,61 @@ function generateBasicTypeMaps(typedef) {
   ].join('\n');
 }
 
-// Render generics as templated types.
+// Whether a list of extended attributes includes `[BigInt]`.
+function hasBigInt(extAttrs) {
+  return (extAttrs || []).some(({ name }) => (name === 'BigInt'));
+}
+
+// A type is marked `[BigInt]` either itself, as in `sequence<[BigInt] long
+// long>`, via the argument, member, attribute, or operation it belongs to, or
+// via a typedef.
+function generateBigIntType(idlType) {
+  const baseType = (bigIntTypedefs[idlType.idlType] || idlType.idlType);
+  if (!bigIntNativeTypes[baseType]) {
+    throw new Error(`[BigInt] applies only to long long and unsigned long ` +
+      `long, not to ${baseType}`);
+  }
+  return bigIntNativeTypes[baseType];
+}
+
+// Render generics as templated types, such as
+// `WebIdlNapi::record<DOMString, WebIdlNapi::sequence<long>>`.
 function generateNativeType(idlType) {
+  if (hasBigInt(idlType.extAttrs) || idlType.bigInt ||
+      (typeof idlType.idlType === 'string' &&
+        idlType.idlType in bigIntTypedefs)) {
+    return generateBigIntType(idlType);
+  }
   return ((typeof idlType.idlType === 'string')
     ? idlType.idlType
-    : `WebIdlNapi::${idlType.generic}<${idlType.idlType[0].idlType}>`);
+    : `WebIdlNapi::${idlType.generic}<` +
+      `${idlType.idlType.map(generateNativeType).join(', ')}>`);
+}
+
+// Whether a type is or contains one marked `[BigInt]`.
+function isBigIntType(idlType) {
+  return (hasBigInt(idlType.extAttrs) || !!idlType.bigInt ||
+    (typeof idlType.idlType === 'string'
+      ? idlType.idlType in bigIntTypedefs
+      : (!!idlType.generic && idlType.idlType.some(isBigIntType))));
+}
+
+// Bindings which deduce their converters from the native declaration would
+// convert a value marked `[BigInt]` via a number if it were declared as a plain
+// 64-bit integer, so we check at compile time that the native type of each
+// such value in `checks` converts like the one the IDL calls for.
+function generateBigIntChecks(member, checks) {
+  return checks
+    .filter(({ idlType }) => (idlType && isBigIntType(idlType)))
+    .reduce((soFar, { nativeType, idlType, description }) => soFar.concat([
+      `static_assert(`,
+      `    WebIdlNapi::BindsAs<`,
+      `        WebIdlNapi::NativeTypes<decltype(${member})>::${nativeType},`,
+      `        ${generateNativeType(idlType)}>::value,`,
+      `    "${description} must be declared as ` +
+        `${generateNativeType(idlType)}");`,
+      ``
+    ]), []);
 }
 
 function generateConverter(idlType) {
@@ -147,6 +244,8 @@ function generateEnumMaps(enumDef) {
       : item.value[0].toUpperCase() +
         item.value.slice(1).replace(/[^0-9a-zA-Z]/g, '_'))
   }), {});
+  const maxLength = Math.max(0,
+    ...enumDef.values.map((val) => Buffer.byteLength(val.value)));
 
   return [
     //
@@ -158,18 +257,24 @@ function generateEnumMaps(enumDef) {
     `    napi_env env,`,
     `    napi_value val,`,
     `    ${enumDef.name}* result) {`,
-    `  DOMString str_val;`,
-    `  napi_status status = WebIdlNapi::Converter<DOMString>::ToNative(`,
+    // The longest value, plus room for one more character of up to four bytes,
+    // so a longer string is recognized as such without being read entirely.
+    `  char str_val[${maxLength + 5}];`,
+    `  size_t length;`,
+    `  napi_status status = napi_get_value_string_utf8(`,
     `      env,`,
     `      val,`,
-    `      &str_val);`,
+    `      str_val,`,
+    `      sizeof(str_val),`,
+    `      &length);`,
     `  if (status != napi_ok) return status;`,
     ``,
     // Generate an if-statement for each possible enum value, and one for the
     // case where the value is not in the list. Join the statements with `else`.
     [
       ...enumDef.values.map((val) => [
-        `  if (!strncmp(str_val.c_str(), "${val.value}", str_val.size())) {`,
+        `  if (length == ${Buffer.byteLength(val.value)} &&`,
+        `      !memcmp(str_val, "${val.value}", length)) {`,
         `    *result = ${enumDef.name}::${valueMap[val.value]};`,
         `  }`,
       ].join('\n')),
@@ -290,16 +395,159 @@ function generateDictionaryMaps(dict) {
   ].join('\n');
 }
 
-// Create an initializer list for signature candidates that will be processed by
-// `WebIdlNapi::PickSignature()`. It may look like this:
-// { { true, { napi_number, object } }, { true, { napi_string, napi_object } }
-function generateSigCandidates(sigs) {
-  return generateInitializerList(
-    sigs.map((sig) => [
-      true,
-      sig.arguments.map((arg) =>
-        typemapWebIDLBasicTypesToNAPI[generateNativeType(arg.idlType)].type)
-    ]), '            ');
+function dictionaryMemberTableName(dict) {
+  return `webidl_napi_dictionary_${dict.name}_members`;
+}
+
+function generateDictionaryMemberTable(dict) {
+  return [
+  `static const WebIdlNapi::DictionaryMember ` +
+    `${dictionaryMemberTableName(dict)}[] =`,
+  generateInitializerList(dict.members.map((member) => [
+    `"${member.name}"`,
+    `offsetof(${dict.name}, ${member.name})`,
+    `WebIdlNapi::ConvertToNative<` +
+      `${generateConverter(member.idlType)}, ` +
+      `${generateNativeType(member.idlType)}>`,
+    `WebIdlNapi::ConvertToJS<` +
+      `${generateConverter(member.idlType)}, ` +
+      `${generateNativeType(member.idlType)}>`
+  ]), '') + ';',
+  ].join('\n');
+}
+
+function isLazyView(dict) {
+  return dict.extAttrs.some(({ name }) => (name === 'LazyView'));
+}
+
+// A dictionary marked `[LazyView]` can also be taken as a
+// `WebIdlNapi::DictionaryView<>`, which finds its members in the same table
+// that compact mode uses. In compact mode the table has already been generated.
+function generateDictionaryViewMembers(dict) {
+  const table = dictionaryMemberTableName(dict);
+  return [
+  ...(argv.compact ? [] : [ generateDictionaryMemberTable(dict), `` ]),
+  `template <>`,
+  `const WebIdlNapi::DictionaryMember*`,
+  `WebIdlNapi::DictionaryView<${dict.name}>::Members(size_t* count) {`,
+  `  *count = sizeof(${table}) / sizeof(*${table});`,
+  `  return ${table};`,
+  `}`,
+  ].join('\n');
+}
+
+function isColumnar(dict) {
+  return dict.extAttrs.some(({ name }) => (name === 'Columnar'));
+}
+
+// A dictionary marked `[Columnar]` can be returned and accepted as a
+// `WebIdlNapi::ColumnarSequence<>`, which stores one column per member and is
+// described by a table of its members. The typed array holding each column in
+// JS is chosen by the IDL type of the member, so that it is the same on all
+// platforms, whatever the size of the native type.
+function generateColumnarMembers(dict) {
+  const table = `webidl_napi_columnar_${dict.name}_members`;
+  const columns = dict.members.map((member) => {
+    const column = columnTypedArrays[generateNativeType(member.idlType)];
+    if (!column) {
+      throw new Error(`Member ${dict.name}.${member.name} of [Columnar] ` +
+        `dictionary ${dict.name} must be numeric`);
+    }
+    return column;
+  });
+  return [
+  `static const WebIdlNapi::ColumnarMember ${table}[] =`,
+  generateInitializerList(dict.members.map((member, idx) => {
+    const nativeType = generateNativeType(member.idlType);
+    const elements =
+      `WebIdlNapi::ColumnElements<${nativeType}, ${columns[idx].element}>`;
+    return [
+      `"${member.name}"`,
+      `offsetof(${dict.name}, ${member.name})`,
+      `sizeof(${nativeType})`,
+      columns[idx].type,
+      `sizeof(${columns[idx].element})`,
+      `${elements}::shared`,
+      `WebIdlNapi::ConvertToNative<` +
+        `${generateConverter(member.idlType)}, ${nativeType}>`,
+      `${elements}::ToElements`,
+      `${elements}::FromElements`
+    ];
+  }), '') + ';',
+  ``,
+  `template <>`,
+  `const WebIdlNapi::ColumnarMember*`,
+  `WebIdlNapi::ColumnarSequence<${dict.name}>::Members(size_t* count) {`,
+  `  *count = sizeof(${table}) / sizeof(*${table});`,
+  `  return ${table};`,
+  `}`,
+  ].join('\n');
+}
+
+// In compact mode a dictionary is described by a table of members which is
+// processed at runtime by `WebIdlNapi::DictionaryToNative()` and
+// `WebIdlNapi::DictionaryToJS()`, instead of having code generated for each
+// member.
+function generateCompactDictionaryMaps(dict) {
+  const table = dictionaryMemberTableName(dict);
+  return [
+  generateDictionaryMemberTable(dict),
+  ``,
+  `template <>`,
+  `napi_status`,
+  `WebIdlNapi::Converter<${dict.name}>::ToNative(`,
+  `    napi_env env,`,
+  `    napi_value val,`,
+  `    ${dict.name}* result) {`,
+  `  return WebIdlNapi::DictionaryToNative(`,
+  `      env,`,
+  `      val,`,
+  `      result,`,
+  `      ${table},`,
+  `      sizeof(${table}) / sizeof(*${table}));`,
+  `}`,
+  ``,
+  `template <>`,
+  `napi_status`,
+  `WebIdlNapi::Converter<${dict.name}>::ToJS(`,
+  `    napi_env env,`,
+  `    const ${dict.name}& val,`,
+  `    napi_value* result) {`,
+  `  return WebIdlNapi::DictionaryToJS(`,
+  `      env,`,
+  `      &val,`,
+  `      result,`,
+  `      ${table},`,
+  `      sizeof(${table}) / sizeof(*${table}));`,
+  `}`,
+  ].join('\n');
+}
+
+// Create the static tables of signature candidates that will be processed by
+// `WebIdlNapi::PickSignature()`, so that picking a signature allocates nothing.
+// They may look like this:
+// static const napi_valuetype sig_0_types[] = { napi_number, napi_object };
+// static const napi_valuetype sig_1_types[] = { napi_string, napi_object };
+// static const WebIdlNapi::SignatureCandidate sigs[] = {
+//   { 2, sig_0_types },
+//   { 2, sig_1_types }
+// };
+function generateSigCandidates(sigs, indent) {
+  return [
+    ...sigs.map((sig, sigIdx) => (sig.arguments.length > 0
+      ? [
+        `static const napi_valuetype sig_${sigIdx}_types[] = {`,
+        sig.arguments.map((arg) => '  ' +
+          typemapWebIDLBasicTypesToNAPI[generateNativeType(arg.idlType)].type)
+          .join(',\n'),
+        `};`
+      ].join('\n')
+      : `static const napi_valuetype* const sig_${sigIdx}_types = nullptr;`)),
+    `static const WebIdlNapi::SignatureCandidate sigs[] = {`,
+    sigs.map((sig, sigIdx) =>
+      `  { ${sig.arguments.length}, sig_${sigIdx}_types }`).join(',\n'),
+    `};`
+  ].join('\n').split('\n').map((line) => indent + line);
 }
 
 function generateParamRetrieval(sigs, maxArgs, isForConstructor) {
@@ -354,14 +602,16 @@ function generateParamRetrieval(sigs, maxArgs, isForConstructor) {
       // constructor.
       ...(isForConstructor ? [ `  if (external == nullptr) {` ] : []) ,
       ...([
-        `    NAPI_CALL(`,
-        `        env,`,
-        `        WebIdlNapi::PickSignature(`,
-        `            env,`,
-        `            argc,`,
-        `            argv,`,
-        `${generateSigCandidates(sigs)},`,
-        `            &sig_idx));`,
+        ...generateSigCandidates(sigs, '  '),
+        `  NAPI_CALL(`,
+        `      env,`,
+        `      WebIdlNapi::PickSignature(`,
+        `          env,`,
+        `          argc,`,
+        `          argv,`,
+        `          sigs,`,
+        `          sizeof(sigs) / sizeof(*sigs),`,
+        `          &sig_idx));`,
       ]
       // If we wrap the `PickSignature` call in an if-statement, we must also
       // indent it by two more spaces.
@@ -465,7 +715,72 @@ function generateCall(ifname, sig, indent, sameObjAttrCount) {
   .join('\n');
 }
 
+// When generating with `--trace`, each binding starts by creating a
+// `WebIdlNapi::TraceScope` which records the begin and end of the call.
+function generateTraceScope(ifname, name) {
+  return (argv.trace ? [
+    `  WebIdlNapi::TraceScope trace_scope(env, info, "${ifname}", "${name}");`
+  ] : []);
+}
+
+// An operation with a single signature is bound via the
+// `WebIdlNapi::Method<>` template, which deduces the argument and return value
+// converters from the signature of the native member function.
+function generateTemplateOperation(ifname, opname, sig) {
+  // Mark optional arguments so that they are left at their default value if
+  // they are `undefined`.
+  const optionalMask = sig.arguments.reduce((soFar, arg, idx) =>
+    ((arg.optional && idx < 32) ? (soFar | (1 << idx)) >>> 0 : soFar), 0);
+  return [
+    ...generateBigIntChecks(`&${ifname}::${opname}`, [
+      {
+        nativeType: 'Return',
+        idlType: sig.idlType,
+        description: `The return value of ${ifname}::${opname}()`
+      },
+      ...sig.arguments.map((arg, idx) => ({
+        nativeType: `Argument<${idx}>`,
+        idlType: arg.idlType,
+        description: `Argument ${idx} of ${ifname}::${opname}()`
+      }))
+    ]),
+    `static napi_value`,
+    `webidl_napi_interface_${ifname}_${opname}(`,
+    `    napi_env env,`,
+    `    napi_callback_info info) {`,
+    ...generateTraceScope(ifname, opname),
+    `  return WebIdlNapi::Method<`,
+    `      decltype(&${ifname}::${opname}),`,
+    `      &${ifname}::${opname},`,
+    `      0x${optionalMask.toString(16)}>::Call(env, info);`,
+    `}`
+  ].join('\n');
+}
+
+// An operation marked `[Batch]` is also bound as `${opname}Batch` via the
+// `WebIdlNapi::BatchMethod<>` template, which calls the native member function
+// once for each item of a batch.
+function generateBatchOperation(ifname, opname, sig) {
+  const optionalMask = sig.arguments.reduce((soFar, arg, idx) =>
+    ((arg.optional && idx < 32) ? (soFar | (1 << idx)) >>> 0 : soFar), 0);
+  return [
+    `static napi_value`,
+    `webidl_napi_interface_${ifname}_${opname}Batch(`,
+    `    napi_env env,`,
+    `    napi_callback_info info) {`,
+    ...generateTraceScope(ifname, `${opname}Batch`),
+    `  return WebIdlNapi::BatchMethod<`,
+    `      decltype(&${ifname}::${opname}),`,
+    `      &${ifname}::${opname},`,
+    `      0x${optionalMask.toString(16)}>::Call(env, info);`,
+    `}`
+  ].join('\n');
+}
+
 function generateIfaceOperation(ifname, opname, sigs, sameObjAttrCount) {
+  if (opname !== 'constructor' && sigs.length === 1) {
+    return generateTemplateOperation(ifname, opname, sigs[0]);
+  }
   if (sigs.length === 0) {
     // If we have no signatures, generate a trivial one.
     sigs = [ {
@@ -485,6 +800,7 @@ function generateIfaceOperation(ifname, opname, sigs, sameObjAttrCount) {
     `webidl_napi_interface_${ifname}_${opname}(`,
     `    napi_env env,`,
     `    napi_callback_info info) {`,
+    ...generateTraceScope(ifname, opname),
     ...(opname === 'constructor' ? [
       `  bool is_construct_call;`,
       `  NAPI_CALL(env,`,
@@ -539,80 +855,78 @@ function generateIfaceOperation(ifname, opname, sigs, sameObjAttrCount) {
   ].join('\n');
 }
 
+// In compact mode all attributes of an interface share the accessors
+// `WebIdlNapi::Accessor<ifname>::Get()` and `WebIdlNapi::Accessor<ifname>::Set()`,
+// so we only generate the descriptor they receive as their `data`.
+function generateCompactIfaceAttribute(ifname, attribute, sameObjIdx) {
+  const converter = generateConverter(attribute.idlType);
+  const nativeType = generateNativeType(attribute.idlType);
+  return [
+    `static WebIdlNapi::AttributeDescriptor`,
+    `webidl_napi_interface_${ifname}_attribute_${attribute.name} =`,
+    generateInitializerList([
+      `offsetof(${ifname}, ${attribute.name})`,
+      (attribute.readonly
+        ? `nullptr`
+        : `WebIdlNapi::ConvertToNative<${converter}, ${nativeType}>`),
+      `WebIdlNapi::ConvertToJS<${converter}, ${nativeType}>`,
+      `${sameObjIdx >= 0 ? sameObjIdx : -1}`
+    ], '') + ';',
+    // When tracing, each attribute needs accessors of its own which record the
+    // call before forwarding it to the shared accessors.
+    ...(argv.trace ? [ 'get', 'set' ]
+      .filter((slug) => (slug === 'get' || !attribute.readonly))
+      .reduce((soFar, slug) => soFar.concat([
+        ``,
+        `static napi_value`,
+        `webidl_napi_interface_${ifname}_${slug}_${attribute.name}(`,
+        `    napi_env env,`,
+        `    napi_callback_info info) {`,
+        ...generateTraceScope(ifname, attribute.name),
+        `  return WebIdlNapi::Accessor<${ifname}>::` +
+          `${slug === 'get' ? 'Get' : 'Set'}(env, info);`,
+        `}`
+      ]), []) : [])
+  ].join('\n');
+}
+
 function generateIfaceAttribute(ifname, attribute, sameObjIdx) {
-  const nativeAttributeType = generateNativeType(attribute.idlType);
-  function generateAccessor(slug) {
+  if (argv.compact) {
+    return generateCompactIfaceAttribute(ifname, attribute, sameObjIdx);
+  }
+  // The accessors are instances of the `WebIdlNapi::Getter<>` and
+  // `WebIdlNapi::Setter<>` templates, which deduce the converter from the type
+  // of the native data member.
+  const member = `&${ifname}::${attribute.name}`;
+  const checks = generateBigIntChecks(member, [ {
+    nativeType: 'Value',
+    idlType: attribute.idlType,
+    description: `${ifname}::${attribute.name}`
+  } ]);
+  function generateAccessor(slug, template) {
     return [
       `static napi_value`,
       `webidl_napi_interface_${ifname}_${slug}_${attribute.name}(`,
       `    napi_env env,`,
       `    napi_callback_info info) {`,
-      `  napi_value js_rcv;`,
-      `  napi_value result = nullptr;`,
-      ...(slug === 'set' ? [
-        `  napi_value js_new;`,
-        `  size_t argc = 1;`,
-      ] : []),
-      `  NAPI_CALL(env,`,
-      `      napi_get_cb_info(env,`,
-      `          info,`,
-      ...(slug === 'set' ? [
-        `          &argc,`,
-        `          &js_new,`,
-      ] : [
-        `          nullptr,`,
-        `          nullptr,`,
-      ]),
-      `          &js_rcv,`,
-      `          nullptr));`,
-      ``,
-      `  ${ifname}* cc_rcv;`,
-      ...((sameObjIdx >= 0 && slug === 'get') ? [
-        `  WebIdlNapi::Wrapping<${ifname}>* wrapping;`,
-        `  NAPI_CALL(env,`,
-        `      WebIdlNapi::Wrapping<${ifname}>::Retrieve(`,
-        `        env,`,
-        `        js_rcv,`,
-        `        &cc_rcv,`,
-        `        ${sameObjIdx},`,
-        `        &result,`,
-        `        &wrapping));`,
-        `  if (result != nullptr) return result;`
-      ] : [
-        `  NAPI_CALL(env,`,
-        `      WebIdlNapi::Wrapping<${ifname}>::Retrieve(`,
-        `        env,`,
-        `        js_rcv,`,
-        `        &cc_rcv));`,
-      ]),
-      ``,
-      ...(slug === 'set' ? [
-        `  NAPI_CALL(`,
-        `      env,`,
-        `      ${generateConverter(attribute.idlType)}::ToNative(`,
-        `          env,`,
-        `          js_new,`,
-        `          &(cc_rcv->${attribute.name})));`,
+      ...generateTraceScope(ifname, attribute.name),
+      `  return WebIdlNapi::${template}<`,
+      `      decltype(${member}),`,
+      ...((slug === 'get' && sameObjIdx >= 0) ? [
+        `      ${member},`,
+        `      ${sameObjIdx}>::Call(env, info);`
       ] : [
-        `  NAPI_CALL(`,
-        `      env,`,
-        `      ${generateConverter(attribute.idlType)}::ToJS(`,
-        `          env,`,
-        `          cc_rcv->${attribute.name},`,
-        `          &result));`,
-        ...((sameObjIdx >= 0 && slug === 'get') ? [
-          `  NAPI_CALL(env, wrapping->SetRef(env, ${sameObjIdx}, result));`,
-        ] : [])
+        `      ${member}>::Call(env, info);`
       ]),
-      `  return result;`,
       `}`,
     ];
   }
   return [
-    ...generateAccessor('get'),
+    ...checks,
+    ...generateAccessor('get', 'Getter'),
     ...(attribute.readonly ? [] : [
       ``,
-      ...generateAccessor('set')
+      ...generateAccessor('set', 'Setter')
     ]),
   ].join('\n');
 }
@@ -648,7 +962,22 @@ function generateIfaceInit(ifname, ops, attributes) {
             ].join(' | ') + ')',
             `nullptr`
           ])),
-        ...attributes.map((attribute) => ([
+        ...attributes.map((attribute) => (argv.compact ? [
+          `"${attribute.name}"`,
+          `nullptr`,
+          `nullptr`,
+          (argv.trace
+            ? `webidl_napi_interface_${ifname}_get_${attribute.name}`
+            : `WebIdlNapi::Accessor<${ifname}>::Get`),
+          (attribute.readonly
+            ? `nullptr`
+            : (argv.trace
+              ? `webidl_napi_interface_${ifname}_set_${attribute.name}`
+              : `WebIdlNapi::Accessor<${ifname}>::Set`)),
+          `nullptr`,
+          `static_cast<napi_property_attributes>(napi_enumerable)`,
+          `&webidl_napi_interface_${ifname}_attribute_${attribute.name}`
+        ] : [
           `"${attribute.name}"`,
           `nullptr`,
           `nullptr`,
@@ -751,6 +1080,22 @@ function generateIface(iface) {
   const collapsedCtors =
     iface.members.filter((item) => (item.type === 'constructor'))
 
+  // Operations marked `[Batch]` also receive a binding named `${opname}Batch`.
+  const batchOps = Object.entries(collapsedOps)
+    .filter(([ , sigs ]) => sigs.some((sig) =>
+      sig.extAttrs.some(({ name }) => (name === 'Batch'))))
+    .reduce((soFar, [ opname, sigs ]) => {
+      if (sigs.length > 1) {
+        throw new Error(`[Batch] operation ${iface.name}.${opname} must not ` +
+          `be overloaded`);
+      }
+      if (collapsedOps[`${opname}Batch`]) {
+        throw new Error(`[Batch] operation ${iface.name}.${opname} conflicts ` +
+          `with operation ${iface.name}.${opname}Batch`);
+      }
+      return Object.assign(soFar, { [`${opname}Batch`]: sigs });
+    }, {});
+
   const { attrs, sameObjAttrs } =
     iface.members.reduce((soFar, item) => {
       if (item.type === 'attribute') {
@@ -780,10 +1125,13 @@ function generateIface(iface) {
       sameObjAttrs.length),
     ...Object.entries(collapsedOps).map(([opname, sigs]) =>
       generateIfaceOperation(iface.name, opname, sigs)),
+    ...Object.values(batchOps).map((sigs) =>
+      generateBatchOperation(iface.name, sigs[0].name, sigs[0])),
     ...attrs.map((item) => generateIfaceAttribute(iface.name, item)),
     ...sameObjAttrs.map((item, idx) =>
       generateIfaceAttribute(iface.name, item, idx)),
-    generateIfaceInit(iface.name, collapsedOps, [...attrs, ...sameObjAttrs])
+    generateIfaceInit(iface.name, { ...collapsedOps, ...batchOps },
+      [...attrs, ...sameObjAttrs])
   ].join('\n\n');
 }
 
@@ -865,6 +1213,20 @@ const extendedTypedefs = tree.filter((item) =>
 
 const enums = tree.filter((item) => (item.type === 'enum'));
 
+// Save the underlying types of typedefs marked `[BigInt]` keyed on their name.
+const bigIntTypedefs = tree.reduce((soFar, item) => Object.assign(soFar,
+  (item.type === 'typedef' && hasBigInt(item.idlType.extAttrs))
+    ? { [item.name]: item.idlType.idlType }
+    : {}), {});
+
+// An extended attribute of an argument, a dictionary member, an attribute, or
+// an operation applies to its type, or, for an operation, its return type.
+tree.forEach((item) => (item.members || []).forEach((member) => {
+  [ member, ...(member.arguments || []) ].forEach((node) => {
+    if (node.idlType && hasBigInt(node.extAttrs)) node.idlType.bigInt = true;
+  });
+}));
+
 // Merge inherited dictionaries into their parents.
 Object.values(dicts).forEach((dict) => {
   if (dict.inheritance) {
@@ -907,7 +1269,19 @@ fs.writeFileSync(outputFile, [
   ...[...enums, ...dictionaries, ...interfaces]
     .map(generateForwardDeclaration),
   ...enums.map(generateEnumMaps),
-  ...dictionaries.map(generateDictionaryMaps),
+  // Member tables record offsets computed with `offsetof`, which compilers
+  // support, but warn about, for classes that are not standard-layout.
+  ...((argv.compact ||
+    dictionaries.some((dict) => (isLazyView(dict) || isColumnar(dict)))) ? [ [
+    `#if defined(__GNUC__)`,
+    `#pragma GCC diagnostic ignored "-Winvalid-offsetof"`,
+    `#endif`
+  ].join('\n') ] : []),
+  ...dictionaries.map(argv.compact
+    ? generateCompactDictionaryMaps
+    : generateDictionaryMaps),
+  ...dictionaries.filter(isLazyView).map(generateDictionaryViewMembers),
+  ...dictionaries.filter(isColumnar).map(generateColumnarMembers),
   ...interfaces.map(generateIface),
   generateInit(interfaces, parsedPath.name)
 ].join('\n\n') + '\n');
@@ -0,0 +1,49 @@
+#include "arena-impl.h"
+
+DOMString Scratch::join(
+    const WebIdlNapi::SequenceView<WebIdlNapi::StringView>& parts,
+    const WebIdlNapi::StringView& separator) {
+  std::string result;
+  for (size_t idx = 0; idx < parts.size(); idx++) {
+    if (idx > 0) result.append(separator.data(), separator.size());
+    result.append(parts[idx].data(), parts[idx].size());
+  }
+  return result;
+}
+
+double Scratch::total(const WebIdlNapi::SequenceView<double>& values) {
+  double result = 0;
+  for (double value: values) result += value;
+  return result;
+}
+
+void Scratch::fill(const WebIdlNapi::SequenceView<double>& values,
+                   double value) {
+  double* items = const_cast<double*>(values.data());
+  for (size_t idx = 0; idx < values.size(); idx++) items[idx] = value;
+}
+
+WebIdlNapi::StringView Scratch::longest(
+    const WebIdlNapi::SequenceView<WebIdlNapi::StringView>& parts) {
+  WebIdlNapi::StringView result;
+  for (const WebIdlNapi::StringView& part: parts)
+    if (part.size() > result.size()) result = part;
+  return result;
+}
+
+unsigned long Scratch::measure(const WebIdlNapi::StringView& text) {
+  return text.size();
+}
+
+unsigned long Scratch::count(
+    const WebIdlNapi::record<
+        WebIdlNapi::StringView,
+        WebIdlNapi::sequence<WebIdlNapi::StringView>>& groups) {
+  unsigned long result = 0;
+  for (const auto& group: groups) {
+    result += group.first.size();
+    for (const WebIdlNapi::StringView& item: group.second)
+      result += item.size();
+  }
+  return result;
+}
@@ -0,0 +1,28 @@
+#ifndef WEBIDL_NAPI_TEST_ARENA_ARENA_IMPL_H
+#define WEBIDL_NAPI_TEST_ARENA_ARENA_IMPL_H
+
+#include "webidl-napi.h"
+
+// Takes its arguments as views, so that they are converted into the arena.
+class Scratch {
+ public:
+  DOMString join(
+      const WebIdlNapi::SequenceView<WebIdlNapi::StringView>& parts,
+      const WebIdlNapi::StringView& separator);
+  double total(const WebIdlNapi::SequenceView<double>& values);
+  // Writes through the view, which shows in JS only if the view refers to the
+  // typed array passed in.
+  void fill(const WebIdlNapi::SequenceView<double>& values, double value);
+  // Returns a view into the arena, which is converted to JS before the arena
+  // is rewound.
+  WebIdlNapi::StringView longest(
+      const WebIdlNapi::SequenceView<WebIdlNapi::StringView>& parts);
+  unsigned long measure(const WebIdlNapi::StringView& text);
+  // Holds views inside owning containers, which also need the arena.
+  unsigned long count(
+      const WebIdlNapi::record<
+          WebIdlNapi::StringView,
+          WebIdlNapi::sequence<WebIdlNapi::StringView>>& groups);
+};
+
+#endif  // WEBIDL_NAPI_TEST_ARENA_ARENA_IMPL_H
@@ -0,0 +1,42 @@
+#include "arena-impl.h"
+
+napi_value arena_init(napi_env env);
+
+static napi_value ArenaInUse(napi_env env, napi_callback_info info) {
+  WebIdlNapi::Arena* arena;
+  napi_value result;
+  NAPI_CALL(env, WebIdlNapi::Arena::GetCurrent(env, &arena));
+  NAPI_CALL(env, napi_create_uint32(env, arena->InUse(), &result));
+  return result;
+}
+
+static napi_value ArenaCapacity(napi_env env, napi_callback_info info) {
+  WebIdlNapi::Arena* arena;
+  napi_value result;
+  NAPI_CALL(env, WebIdlNapi::Arena::GetCurrent(env, &arena));
+  NAPI_CALL(env, napi_create_uint32(env, arena->Capacity(), &result));
+  return result;
+}
+
+NAPI_MODULE_INIT() {
+  napi_value result = arena_init(env);
+  napi_value arena_in_use;
+  NAPI_CALL(env, napi_create_function(env,
+                                      "arenaInUse",
+                                      NAPI_AUTO_LENGTH,
+                                      ArenaInUse,
+                                      nullptr,
+                                      &arena_in_use));
+  NAPI_CALL(env,
+      napi_set_named_property(env, result, "arenaInUse", arena_in_use));
+  napi_value arena_capacity;
+  NAPI_CALL(env, napi_create_function(env,
+                                      "arenaCapacity",
+                                      NAPI_AUTO_LENGTH,
+                                      ArenaCapacity,
+                                      nullptr,
+                                      &arena_capacity));
+  NAPI_CALL(env,
+      napi_set_named_property(env, result, "arenaCapacity", arena_capacity));
+  return result;
+}
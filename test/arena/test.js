@@ -0,0 +1,67 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'arena', module_root: __dirname }));
+
+function test(binding) {
+  const scratch = new binding.Scratch();
+
+  assert.strictEqual(scratch.join([ 'a', 'bc', '' ], ', '), 'a, bc, ');
+  assert.strictEqual(scratch.join([], '-'), '');
+  assert.strictEqual(scratch.total([ 1, 2, 3.5 ]), 6.5);
+  assert.strictEqual(scratch.total(new Float64Array([ 1, 2 ])), 3);
+
+  // Strings longer than the first guess at their size, and multibyte strings
+  // whose last character would not fit into that guess.
+  const long = 'x'.repeat(1000);
+  const multibyte = 'é'.repeat(40);
+  assert.strictEqual(scratch.join([ long, multibyte ], '|'),
+    long + '|' + multibyte);
+  assert.strictEqual(scratch.longest([ 'ab', multibyte, 'abc' ]), multibyte);
+  for (let length = 58; length < 70; length++) {
+    const str = 'y'.repeat(length - 2) + '\u{1f600}';
+    assert.strictEqual(scratch.longest([ str ]), str);
+  }
+
+  // Enough items to need more than one block of the arena.
+  const many = Array.from({ length: 5000 }, (_, idx) => 'item' + idx);
+  assert.strictEqual(scratch.join(many, ','), many.join(','));
+  assert.strictEqual(scratch.total(many.map((_, idx) => idx)),
+    5000 * 4999 / 2);
+
+  // A typed array of the native item type is used in place, while any other
+  // sequence is converted into the arena.
+  const doubles = new Float64Array(3);
+  scratch.fill(doubles, 7);
+  assert.deepStrictEqual(doubles, new Float64Array([ 7, 7, 7 ]));
+  const array = [ 0, 0 ];
+  scratch.fill(array, 7);
+  assert.deepStrictEqual(array, [ 0, 0 ]);
+  const floats = new Float32Array(2);
+  scratch.fill(floats, 7);
+  assert.deepStrictEqual(floats, new Float32Array(2));
+
+  // A batch rewinds the arena after each item.
+  assert.deepStrictEqual(scratch.measureBatch([ [ 'a' ], [ long ], [ 'é' ] ]),
+    [ 1, 1000, 2 ]);
+
+  // Views nested in records and sequences are converted into the arena too.
+  assert.strictEqual(scratch.count({ ab: [ 'c', long ], é: [] }), 1005);
+  assert.strictEqual(binding.arenaInUse(), 0);
+
+  // Failed conversions leave nothing behind either.
+  assert.throws(() => scratch.join([ 'a', 1 ], ','));
+
+  // Nothing remains allocated once the calls have returned.
+  assert.strictEqual(binding.arenaInUse(), 0);
+
+  // Blocks larger than the standard size are freed once the call returns,
+  // while the standard ones are kept for reuse.
+  const capacity = binding.arenaCapacity();
+  const huge = 'z'.repeat(1 << 20);
+  assert.strictEqual(scratch.longest([ 'a', huge ]), huge);
+  assert.strictEqual(scratch.total(new Array(1 << 16).fill(1)), 1 << 16);
+  assert.deepStrictEqual(scratch.measureBatch([ [ huge ], [ 'a' ] ]),
+    [ 1 << 20, 1 ]);
+  assert.strictEqual(binding.arenaCapacity(), capacity);
+  assert.strictEqual(binding.arenaInUse(), 0);
+}
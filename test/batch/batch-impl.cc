@@ -0,0 +1,26 @@
+#include "batch-impl.h"
+
+double Batcher::scale(double value, double factor) {
+  calls++;
+  return value * factor;
+}
+
+DOMString Batcher::greet(const DOMString& name, const DOMString& greeting) {
+  calls++;
+  return std::string(greeting.empty() ? "Hello" : greeting.c_str()) + ", " +
+      name.c_str();
+}
+
+bool Batcher::isEven(unsigned long value) {
+  calls++;
+  return (value % 2) == 0;
+}
+
+unsigned long Batcher::sum(const WebIdlNapi::sequence<unsigned long>& items) {
+  unsigned long result = 0;
+  calls++;
+  for (unsigned long item: items) result += item;
+  return result;
+}
+
+int32_t Batcher::negate(int32_t value) { return -value; }
@@ -0,0 +1,17 @@
+#ifndef WEBIDL_NAPI_TEST_BATCH_BATCH_IMPL_H
+#define WEBIDL_NAPI_TEST_BATCH_BATCH_IMPL_H
+
+#include "webidl-napi.h"
+
+class Batcher {
+ public:
+  double scale(double value, double factor);
+  DOMString greet(const DOMString& name, const DOMString& greeting);
+  bool isEven(unsigned long value);
+  unsigned long sum(const WebIdlNapi::sequence<unsigned long>& items);
+  static int32_t negate(int32_t value);
+  // The number of calls made to the native instance.
+  unsigned long calls = 0;
+};
+
+#endif  // WEBIDL_NAPI_TEST_BATCH_BATCH_IMPL_H
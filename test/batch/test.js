@@ -0,0 +1,68 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'batch', module_root: __dirname }));
+
+function test(binding) {
+  const batcher = new binding.Batcher();
+
+  // An array of argument arrays produces an array of results.
+  assert.deepStrictEqual(batcher.scaleBatch([ [ 1, 2 ], [ 3, 4 ] ]), [ 2, 12 ]);
+  assert.deepStrictEqual(batcher.scaleBatch([]), []);
+  assert.deepStrictEqual(batcher.sumBatch([ [ [ 1, 2 ] ], [ [ 3, 4, 5 ] ] ]),
+    [ 3, 12 ]);
+
+  // An optional argument missing from one item does not keep its value from
+  // the previous item.
+  assert.deepStrictEqual(
+    batcher.greetBatch([ [ 'Ann' ], [ 'Bob', 'Hi' ], [ 'Cy' ] ]),
+    [ 'Hello, Ann', 'Hi, Bob', 'Hello, Cy' ]);
+
+  // Numeric arguments can be given as typed arrays of any element type, and
+  // numeric results are returned in a Float64Array.
+  assert.deepStrictEqual(
+    batcher.scaleBatch(new Float64Array([ 1, 3 ]), new Int32Array([ 2, 4 ])),
+    new Float64Array([ 2, 12 ]));
+  assert.deepStrictEqual(batcher.isEvenBatch(new Uint32Array([ 2, 3 ])),
+    [ true, false ]);
+  assert.throws(() => batcher.scaleBatch(new Float64Array(2),
+    new Float64Array(3)), TypeError);
+  assert.throws(() => batcher.greetBatch(new Uint8Array(2), new Uint8Array(2)),
+    TypeError);
+
+  // Static operations can be batched as well.
+  assert.deepStrictEqual(binding.Batcher.negateBatch([ [ 1 ], [ -2 ] ]),
+    [ -1, 2 ]);
+
+  // Typed array items convert like the arguments of a single call, including
+  // those which are out of range or not finite.
+  const edgeCases = [ 2 ** 31 + 5, 1e20, -1e20, NaN, Infinity, -Infinity,
+    -0.5, 2 ** 32 + 7, -(2 ** 53), 2 ** 64 ];
+  assert.deepStrictEqual(
+    binding.Batcher.negateBatch(new Float64Array(edgeCases)),
+    new Float64Array(edgeCases.map((value) => binding.Batcher.negate(value))));
+  assert.deepStrictEqual(
+    binding.Batcher.negateBatch(edgeCases.map((value) => [ value ])),
+    edgeCases.map((value) => binding.Batcher.negate(value)));
+  const isEvenBatcher = new binding.Batcher();
+  assert.deepStrictEqual(
+    isEvenBatcher.isEvenBatch(new Float64Array(edgeCases)),
+    edgeCases.map((value) => isEvenBatcher.isEven(value)));
+  assert.throws(() => binding.Batcher.negateBatch(new BigInt64Array(2)),
+    TypeError);
+
+  // Batches larger than a chunk.
+  const count = 5000;
+  const values = Float64Array.from({ length: count }, (_, idx) => idx);
+  const scaled = batcher.scaleBatch(values, new Float64Array(count).fill(3));
+  assert.strictEqual(scaled.length, count);
+  assert.strictEqual(scaled[count - 1], (count - 1) * 3);
+  const greetings =
+    batcher.greetBatch(Array.from({ length: count }, (_, idx) => [ `${idx}` ]));
+  assert.strictEqual(greetings[count - 1], `Hello, ${count - 1}`);
+
+  // The receiver is the same native instance for every item.
+  assert.strictEqual(batcher.calls, 2 + 2 + 3 + 2 + 2 + 2 * count);
+
+  // An item that fails to convert throws.
+  assert.throws(() => batcher.scaleBatch([ [ 1, 2 ], [ 'x', 2 ] ]));
+}
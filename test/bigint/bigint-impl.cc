@@ -0,0 +1,46 @@
+#include "bigint-impl.h"
+
+Timestamp Clock::next(Timestamp after) {
+  return after + 1;
+}
+
+WebIdlNapi::bigint64_t Clock::negate(WebIdlNapi::bigint64_t value) {
+  return -value;
+}
+
+int64_t Clock::asNumber(Timestamp value) {
+  return static_cast<int64_t>(value);
+}
+
+Timestamp Clock::sum(const WebIdlNapi::sequence<Timestamp>& times) {
+  uint64_t result = 0;
+  for (Timestamp time: times) result += time;
+  return result;
+}
+
+WebIdlNapi::sequence<WebIdlNapi::bigint64_t>
+Clock::offsets(const WebIdlNapi::sequence<WebIdlNapi::bigint64_t>& values,
+               WebIdlNapi::bigint64_t base) {
+  WebIdlNapi::sequence<WebIdlNapi::bigint64_t> result;
+  for (WebIdlNapi::bigint64_t value: values) result.push_back(value - base);
+  return result;
+}
+
+DOMString Clock::describe(Timestamp time) {
+  return "time " + std::to_string(static_cast<uint64_t>(time));
+}
+
+DOMString Clock::describe(const DOMString& text) {
+  return std::string("text ") + text.c_str();
+}
+
+WebIdlNapi::ColumnarSequence<Event> Clock::events(unsigned long count) {
+  WebIdlNapi::ColumnarSequence<Event> result(count);
+  WebIdlNapi::bigint64_t* ids = result.Column(&Event::id);
+  Timestamp* times = result.Column(&Event::time);
+  for (unsigned long idx = 0; idx < count; idx++) {
+    ids[idx] = -static_cast<int64_t>(idx);
+    times[idx] = epoch + idx;
+  }
+  return result;
+}
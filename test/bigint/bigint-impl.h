@@ -0,0 +1,30 @@
+#ifndef WEBIDL_NAPI_TEST_BIGINT_BIGINT_IMPL_H
+#define WEBIDL_NAPI_TEST_BIGINT_BIGINT_IMPL_H
+
+#include "webidl-napi.h"
+
+typedef WebIdlNapi::biguint64_t Timestamp;
+
+struct Event {
+  WebIdlNapi::bigint64_t id;
+  Timestamp time;
+};
+
+class Clock {
+ public:
+  Timestamp epoch;
+  Timestamp next(Timestamp after);
+  WebIdlNapi::bigint64_t negate(WebIdlNapi::bigint64_t value);
+  // Converts via a number, losing precision past 2^53.
+  int64_t asNumber(Timestamp value);
+  Timestamp sum(const WebIdlNapi::sequence<Timestamp>& times);
+  WebIdlNapi::sequence<WebIdlNapi::bigint64_t>
+  offsets(const WebIdlNapi::sequence<WebIdlNapi::bigint64_t>& values,
+          WebIdlNapi::bigint64_t base);
+  DOMString describe(Timestamp time);
+  DOMString describe(const DOMString& text);
+  // Event `idx` has id `-idx` and time `epoch + idx`.
+  WebIdlNapi::ColumnarSequence<Event> events(unsigned long count);
+};
+
+#endif  // WEBIDL_NAPI_TEST_BIGINT_BIGINT_IMPL_H
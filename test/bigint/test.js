@@ -0,0 +1,43 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'bigint', module_root: __dirname }));
+
+function test(binding) {
+  const clock = new binding.Clock();
+  const max = 2n ** 64n - 1n;
+
+  // Values past 2^53 survive the round trip.
+  assert.strictEqual(clock.next(max - 1n), max);
+  assert.strictEqual(clock.negate(-(2n ** 63n) + 1n), 2n ** 63n - 1n);
+  clock.epoch = 2n ** 60n + 1n;
+  assert.strictEqual(clock.epoch, 2n ** 60n + 1n);
+
+  // BigInts which do not fit, and numbers, are rejected.
+  assert.throws(() => clock.next(max + 1n));
+  assert.throws(() => clock.next(-1n));
+  assert.throws(() => clock.negate(2n ** 63n));
+  assert.throws(() => clock.next(5));
+
+  // Without `[BigInt]`, 64-bit integers remain numbers.
+  assert.strictEqual(clock.asNumber(2n ** 53n), 2 ** 53);
+
+  // Sequences convert from arrays of BigInts, and from BigInt typed arrays of
+  // the same signedness in bulk.
+  assert.strictEqual(clock.sum([ 1n, 2n, 2n ** 62n ]), 2n ** 62n + 3n);
+  assert.strictEqual(clock.sum(new BigUint64Array([ 1n, max - 1n ])), max);
+  assert.throws(() => clock.sum(new BigInt64Array([ -1n ])));
+  assert.deepStrictEqual(clock.offsets(new BigInt64Array([ 5n, -5n ]), 10n),
+    [ -5n, -15n ]);
+  assert.deepStrictEqual(clock.offsets([ 2n ** 62n ], -(2n ** 62n)),
+    [ -(2n ** 63n) ]);
+
+  // Overloads tell BigInts and strings apart.
+  assert.strictEqual(clock.describe(7n), 'time 7');
+  assert.strictEqual(clock.describe('7'), 'text 7');
+
+  // Columns of 64-bit integers are BigInt typed arrays.
+  const events = clock.events(2);
+  assert.deepStrictEqual(events.id, new BigInt64Array([ 0n, -1n ]));
+  assert.deepStrictEqual(events.time,
+    new BigUint64Array([ 2n ** 60n + 1n, 2n ** 60n + 2n ]));
+}
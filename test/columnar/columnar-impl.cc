@@ -0,0 +1,30 @@
+#include "columnar-impl.h"
+
+WebIdlNapi::ColumnarSequence<Sample> Recorder::record(unsigned long count) {
+  WebIdlNapi::ColumnarSequence<Sample> result(count);
+  double* times = result.Column(&Sample::time);
+  float* values = result.Column(&Sample::value);
+  unsigned long* ids = result.Column(&Sample::id);
+  if (ids == nullptr) return result;
+  for (unsigned long idx = 0; idx < count; idx++) {
+    times[idx] = idx / 2.0;
+    values[idx] = idx * 2.0f;
+    ids[idx] = idx + 1000;
+  }
+  return result;
+}
+
+double Recorder::total(const WebIdlNapi::ColumnarSequence<Sample>& samples) {
+  const double* times = samples.Column(&Sample::time);
+  const float* values = samples.Column(&Sample::value);
+  const unsigned long* ids = samples.Column(&Sample::id);
+  double result = 0;
+  for (size_t idx = 0; idx < samples.size(); idx++)
+    result += times[idx] + values[idx] + ids[idx];
+  return result;
+}
+
+WebIdlNapi::ColumnarSequence<Sample> Recorder::echo(
+    const WebIdlNapi::ColumnarSequence<Sample>& samples) {
+  return samples;
+}
@@ -0,0 +1,22 @@
+#ifndef WEBIDL_NAPI_TEST_COLUMNAR_COLUMNAR_IMPL_H
+#define WEBIDL_NAPI_TEST_COLUMNAR_COLUMNAR_IMPL_H
+
+#include "webidl-napi.h"
+
+struct Sample {
+  double time;
+  float value;
+  unsigned long id;
+};
+
+class Recorder {
+ public:
+  // Sample `idx` has time `idx / 2`, value `idx * 2`, and id `idx + 1000`.
+  WebIdlNapi::ColumnarSequence<Sample> record(unsigned long count);
+  // The sum of the times, values, and ids.
+  double total(const WebIdlNapi::ColumnarSequence<Sample>& samples);
+  WebIdlNapi::ColumnarSequence<Sample> echo(
+      const WebIdlNapi::ColumnarSequence<Sample>& samples);
+};
+
+#endif  // WEBIDL_NAPI_TEST_COLUMNAR_COLUMNAR_IMPL_H
@@ -0,0 +1,71 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'columnar', module_root: __dirname }));
+
+function test(binding) {
+  const recorder = new binding.Recorder();
+
+  // The samples arrive as one typed array per member.
+  const samples = recorder.record(4);
+  assert.strictEqual(samples.length, 4);
+  assert.deepStrictEqual(samples.time, new Float64Array([ 0, 0.5, 1, 1.5 ]));
+  assert.deepStrictEqual(samples.value, new Float32Array([ 0, 2, 4, 6 ]));
+  // Columns are typed by the IDL type of their member, so an `unsigned long`
+  // arrives as a `Uint32Array` whatever the size of the native type.
+  assert.deepStrictEqual(samples.id,
+    new Uint32Array([ 1000, 1001, 1002, 1003 ]));
+  assert.deepStrictEqual(Object.keys(samples),
+    [ 'length', 'time', 'value', 'id' ]);
+
+  // Columns which cannot be allocated fail the conversion.
+  assert.throws(() => recorder.record(2 ** 53 - 1));
+  assert.throws(() => recorder.record(2 ** 62));
+
+  const empty = recorder.record(0);
+  assert.strictEqual(empty.length, 0);
+  assert.strictEqual(empty.time.length, 0);
+
+  // Columns of the right type are copied whole, and other columns are
+  // converted item by item.
+  assert.strictEqual(recorder.total(samples), 3 + 12 + 4006);
+  assert.strictEqual(recorder.total({
+    length: 2,
+    time: [ 1, 2 ],
+    value: new Float64Array([ 3, 4 ]),
+    id: [ 5, 6 ]
+  }), 21);
+  assert.strictEqual(recorder.total({
+    length: 2,
+    time: new Float64Array([ 0.5, 0.5 ]),
+    value: new Float32Array([ 1, 1 ]),
+    id: new Uint32Array([ 2 ** 32 - 1, 3 ])
+  }), 3 + 2 ** 32 + 2);
+  assert.throws(() => recorder.total({ length: 1, time: [ 'x' ] }));
+
+  // A `length` which the columns do not match is rejected before anything is
+  // allocated for it.
+  assert.throws(() => recorder.total({
+    length: 3,
+    time: [ 1, 2 ],
+    value: [ 3, 4 ],
+    id: [ 5, 6 ]
+  }));
+  assert.throws(() => recorder.total({
+    length: 4e9,
+    time: new Float64Array(1),
+    value: new Float32Array(1),
+    id: new Uint32Array(1)
+  }));
+  assert.throws(() => recorder.total({ length: 4e9 }));
+
+  // Columns received are copied, so the result does not alias the argument.
+  const echoed = recorder.echo(samples);
+  assert.notStrictEqual(echoed.time, samples.time);
+  assert.deepStrictEqual(echoed, samples);
+
+  // The columns outlive the native sequence they were created for.
+  const many = recorder.record(100000);
+  global.gc();
+  assert.strictEqual(many.id[99999], 100999);
+  assert.strictEqual(many.time[99999], 49999.5);
+}
@@ -0,0 +1,25 @@
+#include "compact-impl.h"
+
+Canvas::Canvas(): frame{"frame", {}, {0, 0}} {}
+
+Shape Canvas::translate(const Shape& shape, double dx, double dy) {
+  Shape result = shape;
+  for (Point& point: result.points) {
+    point.x += dx;
+    point.y += dy;
+  }
+  result.center.x += dx;
+  result.center.y += dy;
+  return result;
+}
+
+unsigned long Canvas::resize(unsigned long new_width,
+                             unsigned long new_height) {
+  width = new_width;
+  height = new_height;
+  frame.points.clear();
+  frame.points.push_back({0, 0});
+  frame.points.push_back({double(width), double(height)});
+  frame.center = {width / 2.0, height / 2.0};
+  return width * height;
+}
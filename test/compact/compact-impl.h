@@ -0,0 +1,30 @@
+#ifndef WEBIDL_NAPI_TEST_COMPACT_COMPACT_IMPL_H
+#define WEBIDL_NAPI_TEST_COMPACT_COMPACT_IMPL_H
+
+#include "webidl-napi.h"
+
+struct Point {
+  double x;
+  double y;
+};
+
+struct Shape {
+  DOMString name;
+  WebIdlNapi::sequence<Point> points;
+  Point center;
+};
+
+class Canvas {
+ public:
+  Canvas();
+  Shape translate(const Shape& shape, double dx, double dy);
+  // Returns the new area.
+  unsigned long resize(unsigned long new_width, unsigned long new_height);
+  unsigned long width = 0;
+  unsigned long height = 0;
+  DOMString title;
+  Shape frame;
+  Shape selection;
+};
+
+#endif  // WEBIDL_NAPI_TEST_COMPACT_COMPACT_IMPL_H
@@ -0,0 +1,75 @@
+'use strict';
+const assert = require('assert');
+const compact =
+  require('bindings')({ bindings: 'compact', module_root: __dirname });
+const compactTrace =
+  require('bindings')({ bindings: 'compact_trace', module_root: __dirname });
+
+test(compact);
+test(compactTrace);
+assert.deepStrictEqual(JSON.parse(compact.getTrace()).traceEvents, []);
+testTrace(compactTrace);
+
+function test(binding) {
+  const canvas = new binding.Canvas();
+
+  // Dictionaries, including nested ones, round-trip via the member tables.
+  const shape = {
+    name: 'triangle',
+    points: [ { x: 0, y: 0 }, { x: 4, y: 0 }, { x: 2, y: 3 } ],
+    center: { x: 2, y: 1 }
+  };
+  assert.deepStrictEqual(canvas.translate(shape, 1, -1), {
+    name: 'triangle',
+    points: [ { x: 1, y: -1 }, { x: 5, y: -1 }, { x: 3, y: 2 } ],
+    center: { x: 3, y: 0 }
+  });
+  assert.throws(() => canvas.translate({ ...shape, center: 5 }, 0, 0));
+
+  // Attributes share the same accessors, but each reads and writes its own
+  // member.
+  assert.strictEqual(canvas.width, 0);
+  canvas.width = 640;
+  canvas.title = 'sketch';
+  assert.strictEqual(canvas.width, 640);
+  assert.strictEqual(canvas.title, 'sketch');
+  assert.throws(() => { canvas.width = 'wide'; });
+  assert.strictEqual(canvas.width, 640);
+
+  canvas.selection = shape;
+  assert.deepStrictEqual(canvas.selection, shape);
+  assert.notStrictEqual(canvas.selection, canvas.selection);
+
+  // Readonly attributes have no setter, so writing them throws in strict mode.
+  assert.strictEqual(canvas.resize(640, 480), 640 * 480);
+  assert.strictEqual(canvas.height, 480);
+  assert.throws(() => { canvas.height = 10; }, TypeError);
+  assert.strictEqual(canvas.height, 480);
+  assert.throws(() => { canvas.frame = shape; }, TypeError);
+
+  // A `[SameObject]` attribute converts once and then returns the same object,
+  // even after the native member changes.
+  const frame = canvas.frame;
+  assert.strictEqual(canvas.frame, frame);
+  canvas.resize(800, 600);
+  assert.strictEqual(canvas.frame, frame);
+  assert.deepStrictEqual(frame, {
+    name: 'frame',
+    points: [ { x: 0, y: 0 }, { x: 640, y: 480 } ],
+    center: { x: 320, y: 240 }
+  });
+  assert.notStrictEqual(new binding.Canvas().frame, frame);
+}
+
+function testTrace(binding) {
+  const canvas = new binding.Canvas();
+  canvas.width = 3;
+  assert.strictEqual(canvas.width, 3);
+  assert.strictEqual(canvas.height, 0);
+  const events = JSON.parse(binding.getTrace()).traceEvents
+    .filter(({ ph }) => (ph === 'B'))
+    .map(({ name }) => name);
+  assert.deepStrictEqual(events.slice(-4), [
+    'Canvas.constructor', 'Canvas.width', 'Canvas.width', 'Canvas.height'
+  ]);
+}
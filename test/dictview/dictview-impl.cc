@@ -0,0 +1,51 @@
+#include "dictview-impl.h"
+
+DOMString Inspector::label(
+    const WebIdlNapi::DictionaryView<Options>& options) {
+  const DOMString* label;
+  if (options.Get(&Options::label, &label) != napi_ok) return DOMString();
+  return *label;
+}
+
+double Inspector::scaledLabelLength(
+    const WebIdlNapi::DictionaryView<Options>& options) {
+  const DOMString* label = nullptr;
+  const DOMString* label_again = nullptr;
+  const double* scale = nullptr;
+  if (options.Get(&Options::label, &label) != napi_ok ||
+      options.Get(&Options::scale, &scale) != napi_ok ||
+      options.Get(&Options::label, &label_again) != napi_ok ||
+      label != label_again)
+    return -1;
+  return strlen(label->c_str()) * *scale;
+}
+
+unsigned long Inspector::maxTextures(
+    const WebIdlNapi::DictionaryView<Options>& options) {
+  WebIdlNapi::DictionaryView<Limits> limits;
+  const unsigned long* max_textures;
+  if (options.GetView(&Options::limits, &limits) != napi_ok ||
+      limits.Get(&Limits::maxTextures, &max_textures) != napi_ok)
+    return 0;
+  return *max_textures;
+}
+
+double Inspector::totalWeight(
+    const WebIdlNapi::DictionaryView<Options>& options) {
+  const WebIdlNapi::sequence<double>* weights;
+  double result = 0;
+  if (options.Get(&Options::weights, &weights) != napi_ok) return -1;
+  for (double weight: *weights) result += weight;
+  return result;
+}
+
+WebIdlNapi::DictionaryView<Options> Inspector::echo(
+    const WebIdlNapi::DictionaryView<Options>& options) {
+  return options;
+}
+
+Limits Inspector::limits(const WebIdlNapi::DictionaryView<Options>& options) {
+  const Limits* limits;
+  if (options.Get(&Options::limits, &limits) != napi_ok) return Limits();
+  return *limits;
+}
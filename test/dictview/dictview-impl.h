@@ -0,0 +1,34 @@
+#ifndef WEBIDL_NAPI_TEST_DICTVIEW_DICTVIEW_IMPL_H
+#define WEBIDL_NAPI_TEST_DICTVIEW_DICTVIEW_IMPL_H
+
+#include "webidl-napi.h"
+
+struct Limits {
+  unsigned long maxTextures;
+  unsigned long maxBuffers;
+};
+
+struct Options {
+  DOMString label;
+  double scale;
+  WebIdlNapi::sequence<double> weights;
+  Limits limits;
+};
+
+// Takes its options as views, and reads only the members it needs.
+class Inspector {
+ public:
+  DOMString label(const WebIdlNapi::DictionaryView<Options>& options);
+  // Reads `label` and `scale`, and `label` twice.
+  double scaledLabelLength(const WebIdlNapi::DictionaryView<Options>& options);
+  unsigned long maxTextures(
+      const WebIdlNapi::DictionaryView<Options>& options);
+  double totalWeight(const WebIdlNapi::DictionaryView<Options>& options);
+  // Returns the object the view was given.
+  WebIdlNapi::DictionaryView<Options> echo(
+      const WebIdlNapi::DictionaryView<Options>& options);
+  // Converts all of `limits` at once.
+  Limits limits(const WebIdlNapi::DictionaryView<Options>& options);
+};
+
+#endif  // WEBIDL_NAPI_TEST_DICTVIEW_DICTVIEW_IMPL_H
@@ -0,0 +1,62 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'dictview', module_root: __dirname }));
+
+// Creates options whose members record when they are read.
+function makeOptions(reads) {
+  const limits = {
+    get maxTextures() { reads.push('limits.maxTextures'); return 16; },
+    get maxBuffers() { reads.push('limits.maxBuffers'); return 8; }
+  };
+  return {
+    get label() { reads.push('label'); return 'abcd'; },
+    get scale() { reads.push('scale'); return 1.5; },
+    get weights() { reads.push('weights'); return [ 1, 2, 3.5 ]; },
+    get limits() { reads.push('limits'); return limits; }
+  };
+}
+
+function test(binding) {
+  const inspector = new binding.Inspector();
+  let reads = [];
+
+  // Only the members which are accessed are read, and each only once.
+  assert.strictEqual(inspector.label(makeOptions(reads)), 'abcd');
+  assert.deepStrictEqual(reads, [ 'label' ]);
+
+  reads = [];
+  assert.strictEqual(inspector.scaledLabelLength(makeOptions(reads)), 6);
+  assert.deepStrictEqual(reads, [ 'label', 'scale' ]);
+
+  reads = [];
+  assert.strictEqual(inspector.totalWeight(makeOptions(reads)), 6.5);
+  assert.deepStrictEqual(reads, [ 'weights' ]);
+
+  // A nested dictionary can be viewed lazily as well, or converted entirely.
+  reads = [];
+  assert.strictEqual(inspector.maxTextures(makeOptions(reads)), 16);
+  assert.deepStrictEqual(reads, [ 'limits', 'limits.maxTextures' ]);
+
+  reads = [];
+  assert.deepStrictEqual(inspector.limits(makeOptions(reads)),
+    { maxTextures: 16, maxBuffers: 8 });
+  assert.deepStrictEqual(reads,
+    [ 'limits', 'limits.maxTextures', 'limits.maxBuffers' ]);
+
+  // A view converts back to the object it was given.
+  const options = makeOptions([]);
+  assert.strictEqual(inspector.echo(options), options);
+
+  // A member of the wrong type throws once it is accessed, as it does when
+  // the dictionary is converted entirely, and members which are never
+  // accessed are not checked.
+  assert.throws(() => inspector.label({ label: 5 }));
+  assert.throws(() => inspector.limits({ limits: { maxTextures: 'x' } }));
+  assert.throws(() => inspector.maxTextures({ limits: 5 }), TypeError);
+  assert.throws(() => inspector.maxTextures({ limits: { maxTextures: 'x' } }));
+  assert.strictEqual(inspector.label({ label: 'a', scale: 'x' }), 'a');
+
+  // Anything other than an object is rejected right away.
+  assert.throws(() => inspector.label(5), TypeError);
+  assert.throws(() => inspector.echo('options'), TypeError);
+}
@@ -0,0 +1,20 @@
+#include "record-impl.h"
+
+WebIdlNapi::record<DOMString, unsigned long>
+Records::scale(const WebIdlNapi::record<DOMString, unsigned long>& input,
+               unsigned long factor) {
+  WebIdlNapi::record<DOMString, unsigned long> result;
+  result.reserve(input.size());
+  for (const auto& item: input)
+    result.emplace_back(item.first, item.second * factor);
+  return result;
+}
+
+WebIdlNapi::sequence<DOMString>
+Records::keys(const WebIdlNapi::record<DOMString, object>& input) {
+  WebIdlNapi::sequence<DOMString> result;
+  for (const auto& item: input) result.push_back(item.first);
+  return result;
+}
+
+Config Records::echoConfig(const Config& config) { return config; }
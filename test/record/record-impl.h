@@ -0,0 +1,21 @@
+#ifndef WEBIDL_NAPI_TEST_RECORD_RECORD_IMPL_H
+#define WEBIDL_NAPI_TEST_RECORD_RECORD_IMPL_H
+
+#include "webidl-napi.h"
+
+struct Config {
+  DOMString name;
+  WebIdlNapi::record<DOMString, DOMString> settings;
+};
+
+class Records {
+ public:
+  WebIdlNapi::record<DOMString, unsigned long>
+  scale(const WebIdlNapi::record<DOMString, unsigned long>& input,
+        unsigned long factor);
+  WebIdlNapi::sequence<DOMString>
+  keys(const WebIdlNapi::record<DOMString, object>& input);
+  Config echoConfig(const Config& config);
+};
+
+#endif  // WEBIDL_NAPI_TEST_RECORD_RECORD_IMPL_H
@@ -0,0 +1,43 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'record', module_root: __dirname }));
+
+function test(binding) {
+  const records = new binding.Records();
+
+  assert.deepStrictEqual(records.scale({}, 2), {});
+  assert.deepStrictEqual(records.scale({ a: 1, b: 2, c: 3 }, 2),
+                         { a: 2, b: 4, c: 6 });
+  assert.throws(() => records.scale({ a: 1, b: 'two' }, 2));
+
+  // Keys keep property order, numeric keys are converted to strings, and
+  // symbol-keyed, inherited, and non-enumerable properties are skipped.
+  const input = Object.create({ inherited: {} });
+  input.z = {};
+  input[Symbol('symbol')] = {};
+  input[5] = {};
+  Object.defineProperty(input, 'hidden', { value: {}, enumerable: false });
+  input.a = {};
+  assert.deepStrictEqual(records.keys(input), [ '5', 'z', 'a' ]);
+
+  // The resulting object has plain data properties.
+  const scaled = records.scale({ x: 1 }, 3);
+  const descriptor = Object.getOwnPropertyDescriptor(scaled, 'x');
+  assert.deepStrictEqual(descriptor,
+    { value: 3, writable: true, enumerable: true, configurable: true });
+
+  const config = {
+    name: 'config',
+    settings: { mode: 'fast', level: 'high' }
+  };
+  assert.deepStrictEqual(records.echoConfig(config), config);
+
+  // A record with many keys spans several conversion chunks.
+  const large = {};
+  const expected = {};
+  for (let idx = 0; idx < 10000; idx++) {
+    large[`key${idx}`] = idx;
+    expected[`key${idx}`] = idx * 2;
+  }
+  assert.deepStrictEqual(records.scale(large, 2), expected);
+}
@@ -0,0 +1,6 @@
+#include "sequence-impl.h"
+
+WebIdlNapi::sequence<unsigned long>
+Sequences::roundTrip(const WebIdlNapi::sequence<unsigned long>& items) {
+  return items;
+}
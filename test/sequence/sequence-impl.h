@@ -0,0 +1,12 @@
+#ifndef WEBIDL_NAPI_TEST_SEQUENCE_SEQUENCE_IMPL_H
+#define WEBIDL_NAPI_TEST_SEQUENCE_SEQUENCE_IMPL_H
+
+#include "webidl-napi.h"
+
+class Sequences {
+ public:
+  WebIdlNapi::sequence<unsigned long>
+  roundTrip(const WebIdlNapi::sequence<unsigned long>& items);
+};
+
+#endif  // WEBIDL_NAPI_TEST_SEQUENCE_SEQUENCE_IMPL_H
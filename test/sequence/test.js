@@ -0,0 +1,38 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'sequence', module_root: __dirname }));
+
+function test(binding) {
+  const sequences = new binding.Sequences();
+
+  assert.deepStrictEqual(sequences.roundTrip([]), []);
+  assert.deepStrictEqual(sequences.roundTrip([ 1, 2, 3 ]), [ 1, 2, 3 ]);
+  assert.throws(() => sequences.roundTrip([ 1, 'two', 3 ]));
+  assert.deepStrictEqual(sequences.roundTrip(new Uint32Array([ 4, 5 ])),
+    [ 4, 5 ]);
+  assert.throws(() => sequences.roundTrip(new BigUint64Array([ 2n ** 60n ])));
+
+  // Round-trip a large sequence and measure how far the peak resident set
+  // grows while doing so. The native copies of the sequence and the resulting
+  // JS array account for roughly three times the size of the elements. Keeping
+  // a handle to every element alive during conversion would add twice as much
+  // again.
+  const count = 5000000;
+  const payload = count * 8;
+  const items = new Array(count);
+  for (let idx = 0; idx < count; idx++) items[idx] = idx;
+
+  global.gc();
+  const rssBefore = process.memoryUsage().rss;
+  const result = sequences.roundTrip(items);
+  const peakGrowth = process.resourceUsage().maxRSS * 1024 - rssBefore;
+
+  assert.strictEqual(result.length, count);
+  for (let idx = 0; idx < count; idx++) {
+    if (result[idx] !== idx) assert.strictEqual(result[idx], idx);
+  }
+  console.log(`Peak RSS growth for a ${count}-element round trip: ` +
+    `${(peakGrowth / (1024 * 1024)).toFixed(1)} MiB`);
+  assert(peakGrowth < 4 * payload,
+    `peak RSS grew by ${peakGrowth} bytes, expected less than ${4 * payload}`);
+}
@@ -0,0 +1,25 @@
+#include "trace-impl.h"
+
+napi_value trace_init(napi_env env);
+
+static napi_value GetTrace(napi_env env, napi_callback_info info) {
+  std::string json;
+  napi_value result;
+  NAPI_CALL(env, WebIdlNapi::GetChromeTrace(env, &json));
+  NAPI_CALL(env,
+      napi_create_string_utf8(env, json.c_str(), json.size(), &result));
+  return result;
+}
+
+NAPI_MODULE_INIT() {
+  napi_value result = trace_init(env);
+  napi_value get_trace;
+  NAPI_CALL(env, napi_create_function(env,
+                                      "getTrace",
+                                      NAPI_AUTO_LENGTH,
+                                      GetTrace,
+                                      nullptr,
+                                      &get_trace));
+  NAPI_CALL(env, napi_set_named_property(env, result, "getTrace", get_trace));
+  return result;
+}
@@ -0,0 +1,41 @@
+'use strict';
+const assert = require('assert');
+test(require('bindings')({ bindings: 'trace', module_root: __dirname }));
+
+function test(binding) {
+  const tracer = new binding.Tracer();
+  assert.strictEqual(tracer.add(2, 3), 5);
+  assert.strictEqual(tracer.echo('hello'), 'hello');
+  assert.strictEqual(tracer.sum([ 1, 2, 3 ]), 6);
+  tracer.counter = 7;
+  assert.strictEqual(tracer.counter, 7);
+
+  const events = JSON.parse(binding.getTrace()).traceEvents;
+  assert.deepStrictEqual(events.map(({ name, ph }) => `${ph} ${name}`), [
+    'B Tracer.constructor', 'E Tracer.constructor',
+    'B Tracer.add', 'E Tracer.add',
+    'B Tracer.echo', 'E Tracer.echo',
+    'B Tracer.sum', 'E Tracer.sum',
+    'B Tracer.counter', 'E Tracer.counter',
+    'B Tracer.counter', 'E Tracer.counter'
+  ]);
+
+  // Begin events carry the argument count and sizes.
+  const begins = events.filter(({ ph }) => (ph === 'B'));
+  assert.deepStrictEqual(begins.map(({ args }) => args), [
+    { argc: 0, argSizes: [] },
+    { argc: 2, argSizes: [ 0, 0 ] },
+    { argc: 1, argSizes: [ 5 ] },
+    { argc: 1, argSizes: [ 3 ] },
+    { argc: 1, argSizes: [ 0 ] },
+    { argc: 0, argSizes: [] }
+  ]);
+
+  // Timestamps never go backwards, and all events come from the same thread.
+  events.reduce((previous, event) => {
+    assert(event.ts >= previous.ts);
+    assert.strictEqual(event.pid, process.pid);
+    assert.strictEqual(event.tid, events[0].tid);
+    return event;
+  });
+}
@@ -0,0 +1,11 @@
+#include "trace-impl.h"
+
+unsigned long Tracer::add(unsigned long a, unsigned long b) { return a + b; }
+
+DOMString Tracer::echo(const DOMString& text) { return text; }
+
+unsigned long Tracer::sum(const WebIdlNapi::sequence<unsigned long>& items) {
+  unsigned long result = 0;
+  for (unsigned long item: items) result += item;
+  return result;
+}
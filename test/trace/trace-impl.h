@@ -0,0 +1,14 @@
+#ifndef WEBIDL_NAPI_TEST_TRACE_TRACE_IMPL_H
+#define WEBIDL_NAPI_TEST_TRACE_TRACE_IMPL_H
+
+#include "webidl-napi.h"
+
+class Tracer {
+ public:
+  unsigned long add(unsigned long a, unsigned long b);
+  DOMString echo(const DOMString& text);
+  unsigned long sum(const WebIdlNapi::sequence<unsigned long>& items);
+  unsigned long counter = 0;
+};
+
+#endif  // WEBIDL_NAPI_TEST_TRACE_TRACE_IMPL_H
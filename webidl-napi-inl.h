@@ -7,12 +7,18 @@ namespace WebIdlNapi {
 
 namespace details {
 
+// Sequences are converted in chunks of this many elements, each within a
+// handle scope of its own, so that converting a large sequence does not keep a
+// handle to each of its elements alive until the conversion completes.
+static const uint32_t kSequenceChunkSize = 1024;
+
 template <typename ArrayType, typename T, bool freeze>
 static inline napi_status
 ArrayToJS(napi_env env, const ArrayType& ar, napi_value* result) {
   napi_status status;
   napi_escapable_handle_scope scope;
   napi_value res;
+  uint32_t size = static_cast<uint32_t>(ar.size());
 
   // TODO(gabrielschulhof): Once `napi_freeze_object` becomes available in all
   // versions of N-API at least under experimental, we can start using this
@@ -22,17 +28,34 @@ ArrayToJS(napi_env env, const ArrayType& ar, napi_value* result) {
   status = napi_open_escapable_handle_scope(env, &scope);
   if (status != napi_ok) return status;
 
-  status = napi_create_array(env, &res);
+  status = napi_create_array_with_length(env, size, &res);
   if (status != napi_ok) goto fail;
 
-  for (int idx = 0; idx < ar.size(); idx++) {
-    napi_value member;
+  for (uint32_t start = 0; start < size; start += kSequenceChunkSize) {
+    uint32_t end = (size - start > kSequenceChunkSize
+        ? start + kSequenceChunkSize
+        : size);
+    napi_handle_scope chunk_scope;
 
-    T item = ar.at(idx);
-    status = Converter<T>::ToJS(env, item, &member);
+    status = napi_open_handle_scope(env, &chunk_scope);
     if (status != napi_ok) goto fail;
 
-    status = napi_set_element(env, res, idx, member);
+    for (uint32_t idx = start; idx < end; idx++) {
+      napi_value member;
+
+      status = Converter<T>::ToJS(env, ar[idx], &member);
+      if (status != napi_ok) break;
+
+      status = napi_set_element(env, res, idx, member);
+      if (status != napi_ok) break;
+    }
+
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, chunk_scope);
+      goto fail;
+    }
+
+    status = napi_close_handle_scope(env, chunk_scope);
     if (status != napi_ok) goto fail;
   }
 
@@ -40,7 +63,7 @@ ArrayToJS(napi_env env, const ArrayType& ar, napi_value* result) {
   if (status != napi_ok) goto fail;
 
   status = napi_close_escapable_handle_scope(env, scope);
-  if (status != napi_ok) goto fail;
+  if (status != napi_ok) return status;
 
   *result = res;
   return napi_ok;
@@ -49,40 +72,201 @@ fail:
   return status;
 }
 
-template <typename ArrayType, typename T>
+// Converts the first `size` elements of the JS array `ar` into `items`, in
+// chunks, each within a handle scope of its own.
+template <typename T>
 static inline napi_status
-ArrayToNative(napi_env env, napi_value ar, ArrayType* result) {
+ElementsToNative(napi_env env, napi_value ar, uint32_t size, T* items) {
   napi_status status;
-  napi_handle_scope scope;
-  ArrayType res;
-  uint32_t size;
 
-  status = napi_open_handle_scope(env, &scope);
-  if (status != napi_ok) return status;
+  for (uint32_t start = 0; start < size; start += kSequenceChunkSize) {
+    uint32_t end = (size - start > kSequenceChunkSize
+        ? start + kSequenceChunkSize
+        : size);
+    napi_handle_scope scope;
 
-  status = napi_get_array_length(env, ar, &size);
-  if (status != napi_ok) return status;
+    status = napi_open_handle_scope(env, &scope);
+    if (status != napi_ok) return status;
 
-  res.resize(size);
+    for (uint32_t idx = start; idx < end; idx++) {
+      napi_value member;
 
-  for (int idx = 0; idx < size; idx++) {
-    napi_value member;
+      status = napi_get_element(env, ar, idx, &member);
+      if (status != napi_ok) break;
 
-    status = napi_get_element(env, ar, idx, &member);
-    if (status != napi_ok) goto fail;
+      status = Converter<T>::ToNative(env, member, &items[idx]);
+      if (status != napi_ok) break;
+    }
 
-    status = Converter<T>::ToNative(env, member, &(res.at(idx)));
-    if (status != napi_ok) goto fail;
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, scope);
+      return status;
+    }
+
+    status = napi_close_handle_scope(env, scope);
+    if (status != napi_ok) return status;
   }
 
-  status = napi_close_handle_scope(env, scope);
-  if (status != napi_ok) goto fail;
+  return napi_ok;
+}
 
-  *result = res;
+// Converts a number to `T` the same way `Converter<T>` converts a JS number:
+// modulo 2^32 for integers of up to 32 bits, saturating for 64-bit integers,
+// and with non-finite values becoming zero for both.
+inline uint32_t NumberToUint32Bits(double value) {
+  if (!std::isfinite(value)) return 0;
+  double modulo = std::fmod(std::trunc(value), 4294967296.0);
+  if (modulo < 0) modulo += 4294967296.0;
+  return static_cast<uint32_t>(modulo);
+}
+
+inline int64_t NumberToInt64(double value) {
+  if (!std::isfinite(value)) return 0;
+  if (value >= 9223372036854775808.0) return INT64_MAX;
+  if (value <= -9223372036854775808.0) return INT64_MIN;
+  return static_cast<int64_t>(value);
+}
+
+template <typename T>
+inline T NumberToNative(double value, std::true_type is_integral) {
+  (void) is_integral;
+  return (sizeof(T) <= sizeof(uint32_t)
+      ? static_cast<T>(NumberToUint32Bits(value))
+      : static_cast<T>(NumberToInt64(value)));
+}
+
+template <typename T>
+inline T NumberToNative(double value, std::false_type is_integral) {
+  (void) is_integral;
+  return static_cast<T>(value);
+}
+
+template <typename T>
+inline T NumberToNative(double value) {
+  return NumberToNative<T>(value, std::is_integral<T>());
+}
+
+// Whether the elements of a typed array of type `type` are of type `T`.
+template <typename T>
+struct TypedArrayOf : std::false_type {
+  static inline bool Matches(napi_typedarray_type type) {
+    (void) type;
+    return false;
+  }
+};
+
+#define WEBIDL_NAPI_TYPED_ARRAY_OF(native_type, typedarray_type)           \
+  template <>                                                             \
+  struct TypedArrayOf<native_type> : std::true_type {                     \
+    static inline bool Matches(napi_typedarray_type type) {               \
+      return type == typedarray_type;                                     \
+    }                                                                     \
+  }
+
+WEBIDL_NAPI_TYPED_ARRAY_OF(int8_t, napi_int8_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(uint8_t, napi_uint8_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(int16_t, napi_int16_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(uint16_t, napi_uint16_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(int32_t, napi_int32_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(uint32_t, napi_uint32_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(float, napi_float32_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(double, napi_float64_array);
+// Only values marked `[BigInt]` match BigInt typed arrays. Plain 64-bit
+// integers convert via numbers, which BigInt elements are not.
+WEBIDL_NAPI_TYPED_ARRAY_OF(bigint64_t, napi_bigint64_array);
+WEBIDL_NAPI_TYPED_ARRAY_OF(biguint64_t, napi_biguint64_array);
+
+#undef WEBIDL_NAPI_TYPED_ARRAY_OF
+
+// Whether a sequence of `T` accepts typed arrays, converting them in bulk if
+// `TypedArrayOf<T>` matches, and one element at a time otherwise.
+template <typename T>
+struct AcceptsTypedArray
+    : std::integral_constant<bool,
+          std::is_arithmetic<T>::value || TypedArrayOf<T>::value> {};
+
+// A typed array whose elements are of type `T` is copied in bulk. One whose
+// elements are of another type is converted one element at a time. `*done` is
+// set if `ar` is a typed array.
+template <typename ArrayType, typename T>
+static inline napi_status
+TypedArrayToNative(napi_env env,
+                   napi_value ar,
+                   ArrayType* result,
+                   bool* done,
+                   std::true_type has_typedarray) {
+  napi_typedarray_type type;
+  bool is_typedarray;
+  size_t length;
+  void* data;
+  (void) has_typedarray;
+
+  *done = false;
+  napi_status status = napi_is_typedarray(env, ar, &is_typedarray);
+  if (status != napi_ok || !is_typedarray) return status;
+
+  status = napi_get_typedarray_info(env,
+                                    ar,
+                                    &type,
+                                    &length,
+                                    &data,
+                                    nullptr,
+                                    nullptr);
+  if (status != napi_ok) return status;
+
+  *done = true;
+  if (TypedArrayOf<T>::Matches(type)) {
+    const T* items = static_cast<const T*>(data);
+    result->assign(items, items + length);
+    return napi_ok;
+  }
+
+  result->clear();
+  result->resize(length);
+  return ElementsToNative<T>(env,
+                             ar,
+                             static_cast<uint32_t>(length),
+                             result->data());
+}
+
+template <typename ArrayType, typename T>
+static inline napi_status
+TypedArrayToNative(napi_env env,
+                   napi_value ar,
+                   ArrayType* result,
+                   bool* done,
+                   std::false_type has_typedarray) {
+  (void) env;
+  (void) ar;
+  (void) result;
+  (void) has_typedarray;
+  *done = false;
   return napi_ok;
-fail:
-  napi_close_handle_scope(env, scope);
-  return status;
+}
+
+// The elements are converted directly into `*result`, which is sized once up
+// front. If the conversion fails, `*result` is left partially converted.
+template <typename ArrayType, typename T>
+static inline napi_status
+ArrayToNative(napi_env env, napi_value ar, ArrayType* result) {
+  uint32_t size;
+  bool done;
+
+  napi_status status =
+      TypedArrayToNative<ArrayType, T>(env,
+                                       ar,
+                                       result,
+                                       &done,
+                                       AcceptsTypedArray<T>());
+  if (status != napi_ok || done) return status;
+
+  status = napi_get_array_length(env, ar, &size);
+  if (status != napi_ok) return status;
+
+  result->clear();
+  result->resize(size);
+
+  return ElementsToNative<T>(env, ar, size, result->data());
 }
 
 }  // end of namespace details
@@ -135,6 +319,101 @@ Converter<int64_t>::ToJS(napi_env env,
   return napi_create_int64(env, value, result);
 }
 
+template <typename T>
+inline BigInt<T>::BigInt(): value(0) {}
+
+template <typename T>
+inline BigInt<T>::BigInt(T new_value): value(new_value) {}
+
+template <typename T>
+inline BigInt<T>::operator T() const {
+  return value;
+}
+
+template <typename T, typename R, typename... Args>
+struct NativeTypes<R (T::*)(Args...)> {
+  typedef R Return;
+  template <size_t idx>
+  using Argument = typename std::tuple_element<idx, std::tuple<Args...>>::type;
+};
+
+template <typename T, typename R, typename... Args>
+struct NativeTypes<R (T::*)(Args...) const> {
+  typedef R Return;
+  template <size_t idx>
+  using Argument = typename std::tuple_element<idx, std::tuple<Args...>>::type;
+};
+
+template <typename R, typename... Args>
+struct NativeTypes<R (*)(Args...)> {
+  typedef R Return;
+  template <size_t idx>
+  using Argument = typename std::tuple_element<idx, std::tuple<Args...>>::type;
+};
+
+template <typename T, typename V>
+struct NativeTypes<V T::*> {
+  typedef V Value;
+};
+
+template <typename Native, typename Idl>
+struct BindsAs
+    : std::is_same<typename std::decay<Native>::type, Idl> {};
+
+template <typename Native, typename Idl>
+struct BindsAs<const Native&, Idl> : BindsAs<Native, Idl> {};
+
+template <typename T, typename U>
+struct BindsAs<SequenceView<T>, sequence<U>> : BindsAs<T, U> {};
+
+template <>
+inline napi_status
+Converter<bigint64_t>::ToNative(napi_env env,
+                                napi_value value,
+                                bigint64_t* result) {
+  int64_t native;
+  bool lossless;
+  napi_status status =
+      napi_get_value_bigint_int64(env, value, &native, &lossless);
+  if (status != napi_ok) return status;
+  if (!lossless) return napi_invalid_arg;
+
+  *result = native;
+  return napi_ok;
+}
+
+template <>
+inline napi_status
+Converter<bigint64_t>::ToJS(napi_env env,
+                            const bigint64_t& value,
+                            napi_value* result) {
+  return napi_create_bigint_int64(env, value, result);
+}
+
+template <>
+inline napi_status
+Converter<biguint64_t>::ToNative(napi_env env,
+                                 napi_value value,
+                                 biguint64_t* result) {
+  uint64_t native;
+  bool lossless;
+  napi_status status =
+      napi_get_value_bigint_uint64(env, value, &native, &lossless);
+  if (status != napi_ok) return status;
+  if (!lossless) return napi_invalid_arg;
+
+  *result = native;
+  return napi_ok;
+}
+
+template <>
+inline napi_status
+Converter<biguint64_t>::ToJS(napi_env env,
+                             const biguint64_t& value,
+                             napi_value* result) {
+  return napi_create_bigint_uint64(env, value, result);
+}
+
 template <>
 inline napi_status
 Converter<double>::ToNative(napi_env env,
@@ -151,32 +430,39 @@ Converter<double>::ToJS(napi_env env,
   return napi_create_double(env, value, result);
 }
 
-// TODO(gabrielschulhof): DOMString should be utf16, not utf8.
 template <>
 inline napi_status
-Converter<DOMString>::ToNative(napi_env env,
-                               napi_value str,
-                               DOMString* result) {
-  size_t size;
-
-  napi_status status = napi_get_value_string_utf8(env, str, nullptr, 0, &size);
-  if (status != napi_ok) return status;
+Converter<float>::ToNative(napi_env env,
+                           napi_value value,
+                           float* result) {
+  double from_js;
+  napi_status status = napi_get_value_double(env, value, &from_js);
+  if (status == napi_ok) *result = static_cast<float>(from_js);
+  return status;
+}
 
-  result->resize(size + 1);
-  status = napi_get_value_string_utf8(env, str,
-                                      const_cast<char*>(result->c_str()),
-                                      size + 1, &size);
-  if (status != napi_ok) return status;
+template <>
+inline napi_status
+Converter<float>::ToJS(napi_env env,
+                       const float& value,
+                       napi_value* result) {
+  return napi_create_double(env, static_cast<double>(value), result);
+}
 
-  return napi_ok;
+template <>
+inline napi_status
+Converter<bool>::ToNative(napi_env env,
+                          napi_value value,
+                          bool* result) {
+  return napi_get_value_bool(env, value, result);
 }
 
 template <>
 inline napi_status
-Converter<DOMString>::ToJS(napi_env env,
-                           const DOMString& str,
-                           napi_value* result) {
-  return napi_create_string_utf8(env, str.c_str(), NAPI_AUTO_LENGTH, result);
+Converter<bool>::ToJS(napi_env env,
+                      const bool& value,
+                      napi_value* result) {
+  return napi_get_boolean(env, value, result);
 }
 
 template <>
@@ -215,58 +501,14 @@ Converter<unsigned long>::ToJS(napi_env env,
   return Converter<int64_t>::ToJS(env, to_js, result);
 }
 
-inline napi_status IsConstructCall(napi_env env,
-                                   napi_callback_info info,
-                                   const char* ifname,
-                                   bool* result) {
-  napi_value new_target;
-  bool res = true;
-  napi_status status = napi_get_new_target(env, info, &new_target);
-  if (status != napi_ok) return status;
-
-  if (new_target == nullptr) {
-    status = napi_throw_error(env,
-                              nullptr,
-                              (std::string("Non-construct calls to the `") +
-                                  ifname + "` constructor are not supported.")
-                                  .c_str());
-    if (status != napi_ok) return status;
-    res = false;
-  }
-
-  *result = res;
-  return status;
+template <typename ConverterType, typename T>
+napi_status ConvertToNative(napi_env env, napi_value val, void* result) {
+  return ConverterType::ToNative(env, val, static_cast<T*>(result));
 }
 
-inline napi_status PickSignature(napi_env env,
-                                 size_t argc,
-                                 napi_value* argv,
-                                 std::vector<webidl_sig> sigs,
-                                 int* sig_idx) {
-  // Advance through the signatures one argument type at a time and mark those
-  // as non-candidates whose signature does not correspond to the sequence of
-  // argument types found in the actual arguments.
-  for (size_t idx = 0; idx < argc; idx++) {
-    napi_valuetype val_type;
-    napi_status status = napi_typeof(env, argv[idx], &val_type);
-    if (status != napi_ok) return status;
-    for (auto& sig: sigs)
-      if (sig.candidate)
-        if (idx >= sig.sig.size() || sig.sig[idx] != val_type)
-          sig.candidate = false;
-  }
-
-  // If any signatures are left marked as candidates, return the first one. We
-  // do not touch `sig_idx` if we do not find a candidate, so the caller can set
-  // it to -1 to be informed after this call completes that no candidate was
-  // found.
-  for (size_t idx = 0; idx < sigs.size(); idx++)
-    if (sigs[idx].candidate) {
-      *sig_idx = idx;
-      break;
-    }
-
-  return napi_ok;
+template <typename ConverterType, typename T>
+napi_status ConvertToJS(napi_env env, const void* val, napi_value* result) {
+  return ConverterType::ToJS(env, *static_cast<const T*>(val), result);
 }
 
 template <typename T>
@@ -350,144 +592,733 @@ sequence<T>::ToNative(napi_env env, napi_value val, sequence<T>* result) {
   return details::ArrayToNative<sequence<T>, T>(env, val, result);
 }
 
+inline StringView::StringView(): chars(""), length(0) {}
+
+inline StringView::StringView(const char* new_chars, size_t new_length):
+    chars(new_chars), length(new_length) {}
+
+inline StringView::StringView(const std::string& str):
+    chars(str.c_str()), length(str.size()) {}
+
+inline const char* StringView::data() const {
+  return chars;
+}
+
+inline size_t StringView::size() const {
+  return length;
+}
+
+inline bool StringView::empty() const {
+  return length == 0;
+}
+
+inline const char* StringView::begin() const {
+  return chars;
+}
+
+inline const char* StringView::end() const {
+  return chars + length;
+}
+
 template <typename T>
-inline FrozenArray<T>::FrozenArray(std::initializer_list<T> lst):
-    std::vector<T>(lst) {}
+inline SequenceView<T>::SequenceView(): items(nullptr), count(0) {}
 
 template <typename T>
-inline napi_status
-FrozenArray<T>::ToJS(napi_env env, const FrozenArray<T>& seq, napi_value* result) {
-  return details::ArrayToJS<FrozenArray<T>, T, true>(env, seq, result);
+inline SequenceView<T>::SequenceView(const T* new_items, size_t new_count):
+    items(new_items), count(new_count) {}
+
+template <typename T>
+inline const T* SequenceView<T>::data() const {
+  return items;
+}
+
+template <typename T>
+inline size_t SequenceView<T>::size() const {
+  return count;
+}
+
+template <typename T>
+inline bool SequenceView<T>::empty() const {
+  return count == 0;
+}
+
+template <typename T>
+inline const T* SequenceView<T>::begin() const {
+  return items;
+}
+
+template <typename T>
+inline const T* SequenceView<T>::end() const {
+  return items + count;
+}
+
+template <typename T>
+inline const T& SequenceView<T>::operator[](size_t idx) const {
+  return items[idx];
 }
 
+// static
 template <typename T>
 inline napi_status
-FrozenArray<T>::ToNative(napi_env env, napi_value val, FrozenArray<T>* result) {
-  return details::ArrayToNative<FrozenArray<T>, T>(env, val, result);
+SequenceView<T>::ToJS(napi_env env,
+                      const SequenceView<T>& seq,
+                      napi_value* result) {
+  return details::ArrayToJS<SequenceView<T>, T, false>(env, seq, result);
 }
 
-// We assume that we are in control of the instance data for this add-on. Even
-// so, we also assume that there may be multiple generated files bundled into
-// this add-on, each of which uses `InstanceData` to manage its state. Thus,
-// if no data is set, we set a new instance, and if one is already set, we
-// assume it's an instance of `InstanceData` and use that.
+// A typed array of the right type is used in place. Otherwise, the items are
+// converted into storage allocated from the arena.
 // static
+template <typename T>
 inline napi_status
-InstanceData::GetCurrent(napi_env env, InstanceData** result) {
-  void* data = nullptr;
+SequenceView<T>::ToNative(napi_env env,
+                          napi_value val,
+                          SequenceView<T>* result) {
+  static_assert(std::is_trivially_destructible<T>::value,
+                "The items of a SequenceView<T> must be trivially destructible");
+  Arena* arena;
+  uint32_t size;
+  bool is_typedarray;
 
-  napi_status status = napi_get_instance_data(env, &data);
+  napi_status status = napi_is_typedarray(env, val, &is_typedarray);
   if (status != napi_ok) return status;
 
-  if (data == nullptr) {
-    InstanceData* new_data = new InstanceData;
+  if (is_typedarray) {
+    napi_typedarray_type type;
+    size_t length;
+    void* data;
+
+    status = napi_get_typedarray_info(env,
+                                      val,
+                                      &type,
+                                      &length,
+                                      &data,
+                                      nullptr,
+                                      nullptr);
+    if (status != napi_ok) return status;
 
-    data = static_cast<void*>(new_data);
-    status = napi_set_instance_data(env, data, DestroyInstanceData, nullptr);
-    if (status != napi_ok) {
-      delete new_data;
-      return status;
+    if (details::TypedArrayOf<T>::Matches(type)) {
+      *result = SequenceView<T>(static_cast<const T*>(data), length);
+      return napi_ok;
     }
+    size = static_cast<uint32_t>(length);
+  } else {
+    status = napi_get_array_length(env, val, &size);
+    if (status != napi_ok) return status;
   }
 
-  *result = static_cast<InstanceData*>(data);
+  status = Arena::GetCurrent(env, &arena);
+  if (status != napi_ok) return status;
+
+  if (size > SIZE_MAX / sizeof(T)) return napi_generic_failure;
+  T* items = static_cast<T*>(arena->Allocate(size * sizeof(T), alignof(T)));
+  if (items == nullptr) return napi_generic_failure;
+  for (uint32_t idx = 0; idx < size; idx++) new (&items[idx]) T();
+
+  status = details::ElementsToNative<T>(env, val, size, items);
+  if (status != napi_ok) return status;
+
+  *result = SequenceView<T>(items, size);
   return napi_ok;
 }
 
-inline void InstanceData::AddConstructor(const char* name, napi_ref ctor) {
-  ctors[name] = ctor;
-}
+template <typename T>
+inline DictionaryView<T>::DictionaryView() {}
 
-inline void
-InstanceData::SetData(void* new_data, napi_finalize fin_cb, void* new_hint) {
-  data = new_data;
-  cb = fin_cb;
-  hint = new_hint;
-}
+// The member is identified by its offset, which is also how the generated
+// table of members describes it.
+template <typename T>
+inline napi_status
+DictionaryView<T>::FindMember(size_t offset,
+                              const DictionaryMember** member,
+                              size_t* idx) const {
+  size_t count;
+  const DictionaryMember* members = Members(&count);
+
+  for (size_t member_idx = 0; member_idx < count; member_idx++)
+    if (members[member_idx].offset == offset) {
+      *member = &members[member_idx];
+      *idx = member_idx;
+      return napi_ok;
+    }
 
-inline void* InstanceData::GetData() {
-  return data;
+  return napi_invalid_arg;
 }
 
-// static
-inline void
-InstanceData::DestroyInstanceData(napi_env env, void* data, void* hint) {
-  (void) hint;
-  static_cast<InstanceData*>(data)->Destroy(env);
-}
+template <typename T>
+template <typename V>
+inline napi_status
+DictionaryView<T>::Get(V T::* member, const V** result) const {
+  V* value = &(cache.*member);
+  size_t offset = reinterpret_cast<const char*>(value) -
+      reinterpret_cast<const char*>(&cache);
+  const DictionaryMember* desc;
+  size_t idx;
+
+  napi_status status = FindMember(offset, &desc, &idx);
+  if (status != napi_ok) return status;
+
+  uint64_t bit = (idx < 64 ? (static_cast<uint64_t>(1) << idx) : 0);
+  if ((converted & bit) == 0) {
+    napi_value js_member;
 
-inline void InstanceData::Destroy(napi_env env) {
-  for (std::pair<const char*, napi_ref> ctor: ctors) {
-    NAPI_CALL_RETURN_VOID(env, napi_delete_reference(env, ctor.second));
+    status = napi_get_named_property(env, object, desc->name, &js_member);
+    if (status != napi_ok) return Throw(status);
+
+    status = desc->to_native(env, js_member, value);
+    if (status != napi_ok) return Throw(status);
+
+    converted |= bit;
   }
 
-  if (data != nullptr && cb != nullptr) cb(env, data, hint);
+  *result = value;
+  return napi_ok;
+}
+
+template <typename T>
+template <typename V>
+inline napi_status
+DictionaryView<T>::GetView(V T::* member, DictionaryView<V>* result) const {
+  size_t offset = reinterpret_cast<const char*>(&(cache.*member)) -
+      reinterpret_cast<const char*>(&cache);
+  const DictionaryMember* desc;
+  napi_value js_member;
+  size_t idx;
+
+  napi_status status = FindMember(offset, &desc, &idx);
+  if (status != napi_ok) return status;
+
+  status = napi_get_named_property(env, object, desc->name, &js_member);
+  if (status != napi_ok) return Throw(status);
+
+  status = DictionaryView<V>::ToNative(env, js_member, result);
+  if (status != napi_ok) return Throw(status);
+
+  return napi_ok;
 }
 
-inline napi_ref InstanceData::GetConstructor(const char* name) {
-  return ctors[name];
+// A member which fails to convert throws, as an argument which fails to
+// convert does, unless the conversion has already thrown.
+template <typename T>
+inline napi_status DictionaryView<T>::Throw(napi_status status) const {
+  GET_AND_THROW_LAST_ERROR(env);
+  return status;
 }
 
-// static
 template <typename T>
-napi_status Wrapping<T>::Create(napi_env env,
-                                napi_value js_rcv,
-                                T* cc_rcv,
-                                size_t same_obj_count) {
-  Wrapping<T>* wrapping = new Wrapping<T>;
-  wrapping->native = cc_rcv;
-  if (same_obj_count > 0)
-    wrapping->refs.resize(same_obj_count, nullptr);
-  return napi_wrap(env, js_rcv, wrapping, Destroy, nullptr, nullptr);
+inline napi_value DictionaryView<T>::GetObject() const {
+  return object;
 }
 
 // static
 template <typename T>
-napi_status Wrapping<T>::Retrieve(napi_env env,
-                                  napi_value js_rcv,
-                                  T** cc_rcv,
-                                  int ref_idx,
-                                  napi_value* ref,
-                                  Wrapping<T>** get_wrapping) {
-  void* data = nullptr;
+inline napi_status
+DictionaryView<T>::ToJS(napi_env env,
+                        const DictionaryView<T>& view,
+                        napi_value* result) {
+  (void) env;
+  *result = view.object;
+  return napi_ok;
+}
 
-  napi_status status = napi_unwrap(env, js_rcv, &data);
+// Nothing is converted until a member is accessed, and what was converted for
+// a previous object is discarded. Only whether `val` is an object is checked
+// right away.
+// static
+template <typename T>
+inline napi_status
+DictionaryView<T>::ToNative(napi_env env,
+                            napi_value val,
+                            DictionaryView<T>* result) {
+  napi_valuetype type;
+  napi_status status = napi_typeof(env, val, &type);
   if (status != napi_ok) return status;
 
-  Wrapping<T>*wrapping = static_cast<Wrapping<T>*>(data);
-
-  if (ref_idx >= 0 &&
-      ref_idx < wrapping->refs.size() &&
-      wrapping->refs[ref_idx] != nullptr) {
-    napi_value ref_value = nullptr;
-
-    status = napi_get_reference_value(env, wrapping->refs[ref_idx], &ref_value);
-    if (status != napi_ok) return status;
-
-    if (ref != nullptr) *ref = ref_value;
+  if (type != napi_object && type != napi_function) {
+    status = napi_throw_type_error(env, nullptr, "A dictionary was expected");
+    return (status == napi_ok ? napi_pending_exception : status);
   }
 
-  if (get_wrapping != nullptr) *get_wrapping = wrapping;
-  *cc_rcv = wrapping->native;
+  result->env = env;
+  result->object = val;
+  result->converted = 0;
   return napi_ok;
 }
 
 template <typename T>
-inline napi_status
-Wrapping<T>::SetRef(napi_env env, int idx, napi_value same_obj) {
-  napi_ref ref;
+inline ColumnarSequence<T>::ColumnarSequence() {}
 
-  napi_status status = napi_create_reference(env, same_obj, 1, &ref);
-  if (status != napi_ok) return status;
+template <typename T>
+inline ColumnarSequence<T>::ColumnarSequence(size_t new_length):
+    length(new_length) {
+  size_t count;
+  const ColumnarMember* members = Members(&count);
+
+  columns.reserve(count);
+  for (size_t idx = 0; idx < count; idx++) {
+    char* column = (length > SIZE_MAX / members[idx].size
+        ? nullptr
+        : new (std::nothrow) char[length * members[idx].size]());
+    if (column == nullptr) {
+      columns.clear();
+      return;
+    }
+    columns.emplace_back(column, std::default_delete<char[]>());
+  }
+}
 
-  refs[idx] = ref;
-  return napi_ok;
+template <typename T>
+inline size_t ColumnarSequence<T>::size() const {
+  return length;
 }
 
-// static
+// The member is identified by its offset within a `T`, which is also how the
+// generated table of members describes it.
 template <typename T>
-void Wrapping<T>::Destroy(napi_env env, void* data, void* hint) {
-  (void) hint;
+template <typename V>
+inline void* ColumnarSequence<T>::FindColumn(V T::* member) const {
+  T probe;
+  size_t offset = reinterpret_cast<const char*>(&(probe.*member)) -
+      reinterpret_cast<const char*>(&probe);
+  size_t count;
+  const ColumnarMember* members = Members(&count);
+
+  for (size_t idx = 0; idx < count && idx < columns.size(); idx++)
+    if (members[idx].offset == offset) return columns[idx].get();
+
+  return nullptr;
+}
+
+template <typename T>
+template <typename V>
+inline V* ColumnarSequence<T>::Column(V T::* member) {
+  return static_cast<V*>(FindColumn(member));
+}
+
+template <typename T>
+template <typename V>
+inline const V* ColumnarSequence<T>::Column(V T::* member) const {
+  return static_cast<const V*>(FindColumn(member));
+}
+
+// static
+template <typename T>
+inline napi_status
+ColumnarSequence<T>::ToJS(napi_env env,
+                          const ColumnarSequence<T>& seq,
+                          napi_value* result) {
+  size_t count;
+  const ColumnarMember* members = Members(&count);
+  if (seq.columns.size() != count) return napi_generic_failure;
+
+  return ColumnarToJS(env,
+                      seq.length,
+                      seq.columns.data(),
+                      members,
+                      count,
+                      result);
+}
+
+// static
+template <typename T>
+inline napi_status
+ColumnarSequence<T>::ToNative(napi_env env,
+                              napi_value val,
+                              ColumnarSequence<T>* result) {
+  size_t count;
+  const ColumnarMember* members = Members(&count);
+
+  return ColumnarToNative(env,
+                          val,
+                          members,
+                          count,
+                          &result->length,
+                          &result->columns);
+}
+
+namespace details {
+
+// The type whose layout a value of type `T` has.
+template <typename T>
+struct LayoutOf {
+  typedef T type;
+};
+
+template <typename T>
+struct LayoutOf<BigInt<T>> {
+  typedef T type;
+};
+
+template <typename To, typename From>
+inline To ConvertElement(From value, std::true_type from_number) {
+  (void) from_number;
+  return NumberToNative<To>(value);
+}
+
+template <typename To, typename From>
+inline To ConvertElement(From value, std::false_type from_number) {
+  (void) from_number;
+  return static_cast<To>(value);
+}
+
+template <typename To, typename From>
+inline void ConvertElements(const void* from, size_t length, void* to) {
+  for (size_t idx = 0; idx < length; idx++) {
+    static_cast<To*>(to)[idx] = ConvertElement<To>(
+        static_cast<const From*>(from)[idx],
+        std::integral_constant<bool, std::is_floating_point<From>::value &&
+                                     std::is_integral<To>::value>());
+  }
+}
+
+}  // end of namespace details
+
+template <typename V, typename E>
+const bool ColumnElements<V, E>::shared =
+    (sizeof(V) == sizeof(E) &&
+     std::is_floating_point<typename details::LayoutOf<V>::type>::value ==
+         std::is_floating_point<E>::value &&
+     std::is_signed<typename details::LayoutOf<V>::type>::value ==
+         std::is_signed<E>::value);
+
+// static
+template <typename V, typename E>
+inline void ColumnElements<V, E>::ToElements(const void* column,
+                                             size_t length,
+                                             void* elements) {
+  details::ConvertElements<E, V>(column, length, elements);
+}
+
+// static
+template <typename V, typename E>
+inline void ColumnElements<V, E>::FromElements(const void* elements,
+                                               size_t length,
+                                               void* column) {
+  details::ConvertElements<V, E>(elements, length, column);
+}
+
+// The keys are enumerated once, and each key is used both to retrieve its
+// value and, converted, as the key of the native pair. The pairs are converted
+// in chunks, each within a handle scope of its own.
+// static
+template <typename K, typename V>
+inline napi_status
+record<K, V>::ToNative(napi_env env, napi_value val, record<K, V>* result) {
+  napi_value keys;
+  uint32_t size;
+
+  napi_status status =
+      napi_get_all_property_names(env,
+                                  val,
+                                  napi_key_own_only,
+                                  static_cast<napi_key_filter>(
+                                      napi_key_enumerable |
+                                      napi_key_skip_symbols),
+                                  napi_key_numbers_to_strings,
+                                  &keys);
+  if (status != napi_ok) return status;
+
+  status = napi_get_array_length(env, keys, &size);
+  if (status != napi_ok) return status;
+
+  result->clear();
+  result->resize(size);
+
+  for (uint32_t start = 0; start < size;
+       start += details::kSequenceChunkSize) {
+    uint32_t end = (size - start > details::kSequenceChunkSize
+        ? start + details::kSequenceChunkSize
+        : size);
+    napi_handle_scope scope;
+
+    status = napi_open_handle_scope(env, &scope);
+    if (status != napi_ok) return status;
+
+    for (uint32_t idx = start; idx < end; idx++) {
+      std::pair<K, V>& item = (*result)[idx];
+      napi_value js_key, js_value;
+
+      status = napi_get_element(env, keys, idx, &js_key);
+      if (status != napi_ok) break;
+
+      status = Converter<K>::ToNative(env, js_key, &item.first);
+      if (status != napi_ok) break;
+
+      status = napi_get_property(env, val, js_key, &js_value);
+      if (status != napi_ok) break;
+
+      status = Converter<V>::ToNative(env, js_value, &item.second);
+      if (status != napi_ok) break;
+    }
+
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, scope);
+      return status;
+    }
+
+    status = napi_close_handle_scope(env, scope);
+    if (status != napi_ok) return status;
+  }
+
+  return napi_ok;
+}
+
+// The properties are defined a batch at a time via `napi_define_properties()`.
+// static
+template <typename K, typename V>
+inline napi_status
+record<K, V>::ToJS(napi_env env, const record<K, V>& rec, napi_value* result) {
+  static const size_t kBatchSize = 64;
+  napi_property_descriptor props[kBatchSize];
+  napi_escapable_handle_scope scope;
+  napi_value res;
+  size_t size = rec.size();
+
+  napi_status status = napi_open_escapable_handle_scope(env, &scope);
+  if (status != napi_ok) return status;
+
+  status = napi_create_object(env, &res);
+  if (status != napi_ok) goto fail;
+
+  for (size_t start = 0; start < size; start += kBatchSize) {
+    size_t count = (size - start > kBatchSize ? kBatchSize : size - start);
+    napi_handle_scope batch_scope;
+
+    status = napi_open_handle_scope(env, &batch_scope);
+    if (status != napi_ok) goto fail;
+
+    for (size_t idx = 0; idx < count; idx++) {
+      const std::pair<K, V>& item = rec[start + idx];
+      props[idx] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                     static_cast<napi_property_attributes>(
+                         napi_writable | napi_enumerable | napi_configurable),
+                     nullptr };
+
+      status = Converter<K>::ToJS(env, item.first, &props[idx].name);
+      if (status != napi_ok) break;
+
+      status = Converter<V>::ToJS(env, item.second, &props[idx].value);
+      if (status != napi_ok) break;
+    }
+
+    if (status == napi_ok)
+      status = napi_define_properties(env, res, count, props);
+
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, batch_scope);
+      goto fail;
+    }
+
+    status = napi_close_handle_scope(env, batch_scope);
+    if (status != napi_ok) goto fail;
+  }
+
+  status = napi_escape_handle(env, scope, res, &res);
+  if (status != napi_ok) goto fail;
+
+  status = napi_close_escapable_handle_scope(env, scope);
+  if (status != napi_ok) return status;
+
+  *result = res;
+  return napi_ok;
+fail:
+  napi_close_escapable_handle_scope(env, scope);
+  return status;
+}
+
+template <typename T>
+inline FrozenArray<T>::FrozenArray(std::initializer_list<T> lst):
+    std::vector<T>(lst) {}
+
+template <typename T>
+inline napi_status
+FrozenArray<T>::ToJS(napi_env env, const FrozenArray<T>& seq, napi_value* result) {
+  return details::ArrayToJS<FrozenArray<T>, T, true>(env, seq, result);
+}
+
+template <typename T>
+inline napi_status
+FrozenArray<T>::ToNative(napi_env env, napi_value val, FrozenArray<T>* result) {
+  return details::ArrayToNative<FrozenArray<T>, T>(env, val, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<sequence<T>>::ToNative(napi_env env,
+                                 napi_value value,
+                                 sequence<T>* result) {
+  return sequence<T>::ToNative(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<sequence<T>>::ToJS(napi_env env,
+                             const sequence<T>& value,
+                             napi_value* result) {
+  return sequence<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<FrozenArray<T>>::ToNative(napi_env env,
+                                    napi_value value,
+                                    FrozenArray<T>* result) {
+  return FrozenArray<T>::ToNative(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<FrozenArray<T>>::ToJS(napi_env env,
+                                const FrozenArray<T>& value,
+                                napi_value* result) {
+  return FrozenArray<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<SequenceView<T>>::ToNative(napi_env env,
+                                     napi_value value,
+                                     SequenceView<T>* result) {
+  return SequenceView<T>::ToNative(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<SequenceView<T>>::ToJS(napi_env env,
+                                 const SequenceView<T>& value,
+                                 napi_value* result) {
+  return SequenceView<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<DictionaryView<T>>::ToNative(napi_env env,
+                                       napi_value value,
+                                       DictionaryView<T>* result) {
+  return DictionaryView<T>::ToNative(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<DictionaryView<T>>::ToJS(napi_env env,
+                                   const DictionaryView<T>& value,
+                                   napi_value* result) {
+  return DictionaryView<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<ColumnarSequence<T>>::ToNative(napi_env env,
+                                         napi_value value,
+                                         ColumnarSequence<T>* result) {
+  return ColumnarSequence<T>::ToNative(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<ColumnarSequence<T>>::ToJS(napi_env env,
+                                     const ColumnarSequence<T>& value,
+                                     napi_value* result) {
+  return ColumnarSequence<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename K, typename V>
+inline napi_status
+Converter<record<K, V>>::ToNative(napi_env env,
+                                  napi_value value,
+                                  record<K, V>* result) {
+  return record<K, V>::ToNative(env, value, result);
+}
+
+// static
+template <typename K, typename V>
+inline napi_status
+Converter<record<K, V>>::ToJS(napi_env env,
+                              const record<K, V>& value,
+                              napi_value* result) {
+  return record<K, V>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+inline napi_status
+Converter<Promise<T>>::ToJS(napi_env env,
+                            const Promise<T>& value,
+                            napi_value* result) {
+  return Promise<T>::ToJS(env, value, result);
+}
+
+// static
+template <typename T>
+napi_status Wrapping<T>::Create(napi_env env,
+                                napi_value js_rcv,
+                                T* cc_rcv,
+                                size_t same_obj_count) {
+  Wrapping<T>* wrapping = new Wrapping<T>;
+  wrapping->native = cc_rcv;
+  if (same_obj_count > 0)
+    wrapping->refs.resize(same_obj_count, nullptr);
+  return napi_wrap(env, js_rcv, wrapping, Destroy, nullptr, nullptr);
+}
+
+// static
+template <typename T>
+napi_status Wrapping<T>::Retrieve(napi_env env,
+                                  napi_value js_rcv,
+                                  T** cc_rcv,
+                                  int ref_idx,
+                                  napi_value* ref,
+                                  Wrapping<T>** get_wrapping) {
+  void* data = nullptr;
+
+  napi_status status = napi_unwrap(env, js_rcv, &data);
+  if (status != napi_ok) return status;
+
+  Wrapping<T>*wrapping = static_cast<Wrapping<T>*>(data);
+
+  if (ref_idx >= 0 &&
+      ref_idx < wrapping->refs.size() &&
+      wrapping->refs[ref_idx] != nullptr) {
+    napi_value ref_value = nullptr;
+
+    status = napi_get_reference_value(env, wrapping->refs[ref_idx], &ref_value);
+    if (status != napi_ok) return status;
+
+    if (ref != nullptr) *ref = ref_value;
+  }
+
+  if (get_wrapping != nullptr) *get_wrapping = wrapping;
+  *cc_rcv = wrapping->native;
+  return napi_ok;
+}
+
+template <typename T>
+inline napi_status
+Wrapping<T>::SetRef(napi_env env, int idx, napi_value same_obj) {
+  napi_ref ref;
+
+  napi_status status = napi_create_reference(env, same_obj, 1, &ref);
+  if (status != napi_ok) return status;
+
+  refs[idx] = ref;
+  return napi_ok;
+}
+
+// static
+template <typename T>
+void Wrapping<T>::Destroy(napi_env env, void* data, void* hint) {
+  (void) hint;
   Wrapping<T>* wrapping = static_cast<Wrapping<T>*>(data);
 
   for (napi_ref ref: wrapping->refs)
@@ -497,5 +1328,697 @@ void Wrapping<T>::Destroy(napi_env env, void* data, void* hint) {
   delete wrapping;
 }
 
+namespace details {
+
+template <size_t... I>
+struct IndexSequence {};
+
+template <size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct MakeIndexSequence<0, I...> {
+  typedef IndexSequence<I...> type;
+};
+
+template <typename T>
+using Bare = typename std::remove_cv<
+    typename std::remove_reference<T>::type>::type;
+
+// Describes a native function, member function, or static member function
+// `fn`. `Receiver` is `void` for functions that are not called on an instance.
+template <typename Fn, Fn fn>
+struct Invoker;
+
+template <typename T, typename R, typename... Args, R (T::*fn)(Args...)>
+struct Invoker<R (T::*)(Args...), fn> {
+  typedef T Receiver;
+  typedef R Return;
+  typedef std::tuple<Bare<Args>...> Arguments;
+  static const size_t arg_count = sizeof...(Args);
+  template <size_t... I>
+  static inline R Call(T* cc_rcv, Arguments* args, IndexSequence<I...>) {
+    (void) args;
+    return (cc_rcv->*fn)(std::get<I>(*args)...);
+  }
+};
+
+template <typename T, typename R, typename... Args, R (T::*fn)(Args...) const>
+struct Invoker<R (T::*)(Args...) const, fn> {
+  typedef T Receiver;
+  typedef R Return;
+  typedef std::tuple<Bare<Args>...> Arguments;
+  static const size_t arg_count = sizeof...(Args);
+  template <size_t... I>
+  static inline R Call(T* cc_rcv, Arguments* args, IndexSequence<I...>) {
+    (void) args;
+    return (cc_rcv->*fn)(std::get<I>(*args)...);
+  }
+};
+
+template <typename R, typename... Args, R (*fn)(Args...)>
+struct Invoker<R (*)(Args...), fn> {
+  typedef void Receiver;
+  typedef R Return;
+  typedef std::tuple<Bare<Args>...> Arguments;
+  static const size_t arg_count = sizeof...(Args);
+  template <size_t... I>
+  static inline R Call(void* cc_rcv, Arguments* args, IndexSequence<I...>) {
+    (void) cc_rcv;
+    (void) args;
+    return fn(std::get<I>(*args)...);
+  }
+};
+
+// Describes a data member `V T::*`.
+template <typename Member>
+struct MemberOf;
+
+template <typename T, typename V>
+struct MemberOf<V T::*> {
+  typedef T Receiver;
+  typedef V Value;
+};
+
+template <typename T>
+inline napi_status
+RetrieveReceiver(napi_env env, napi_value js_rcv, T** cc_rcv) {
+  return Wrapping<T>::Retrieve(env, js_rcv, cc_rcv);
+}
+
+inline napi_status
+RetrieveReceiver(napi_env env, napi_value js_rcv, void** cc_rcv) {
+  (void) env;
+  (void) js_rcv;
+  *cc_rcv = nullptr;
+  return napi_ok;
+}
+
+// Converts `argv[idx]` through `argv[count - 1]` into the corresponding items
+// of the tuple `args`.
+template <uint32_t optional_mask, size_t idx, size_t count>
+struct ArgsToNative {
+  template <typename Arguments>
+  static inline napi_status
+  Convert(napi_env env, napi_value* argv, Arguments* args) {
+    typedef typename std::tuple_element<idx, Arguments>::type Arg;
+    bool have_arg = true;
+    napi_status status;
+
+    if (idx < 32 && (optional_mask & (1u << (idx % 32))) != 0) {
+      napi_valuetype val_type;
+      status = napi_typeof(env, argv[idx], &val_type);
+      if (status != napi_ok) return status;
+      have_arg = (val_type != napi_undefined);
+    }
+
+    if (have_arg) {
+      status = Converter<Arg>::ToNative(env, argv[idx], &std::get<idx>(*args));
+      if (status != napi_ok) return status;
+    } else {
+      // `args` may hold the arguments of the previous item of a batch.
+      std::get<idx>(*args) = Arg();
+    }
+
+    return ArgsToNative<optional_mask, idx + 1, count>::Convert(env,
+                                                                argv,
+                                                                args);
+  }
+};
+
+template <uint32_t optional_mask, size_t count>
+struct ArgsToNative<optional_mask, count, count> {
+  template <typename Arguments>
+  static inline napi_status
+  Convert(napi_env env, napi_value* argv, Arguments* args) {
+    (void) env;
+    (void) argv;
+    (void) args;
+    return napi_ok;
+  }
+};
+
+// Whether converting a `T` allocates from the arena, which is also the case if
+// it holds views, such as a `sequence<StringView>`. The members of generated
+// dictionaries are of the types the IDL calls for, which are never views.
+template <typename T>
+struct UsesArena : std::false_type {};
+
+template <>
+struct UsesArena<StringView> : std::true_type {};
+
+template <typename T>
+struct UsesArena<SequenceView<T>> : std::true_type {};
+
+template <typename T>
+struct UsesArena<sequence<T>> : UsesArena<T> {};
+
+template <typename T>
+struct UsesArena<FrozenArray<T>> : UsesArena<T> {};
+
+template <typename K, typename V>
+struct UsesArena<record<K, V>>
+    : std::integral_constant<bool,
+          UsesArena<K>::value || UsesArena<V>::value> {};
+
+template <typename... Args>
+struct UsesArena<std::tuple<Args...>> : std::false_type {};
+
+template <typename Arg, typename... Args>
+struct UsesArena<std::tuple<Arg, Args...>>
+    : std::integral_constant<bool,
+          UsesArena<Arg>::value ||
+          UsesArena<std::tuple<Args...>>::value> {};
+
+// Stands in for an `ArenaScope` in calls whose arguments do not need the
+// arena, so that those calls do not look the arena up at all.
+struct NoArenaScope {
+  explicit inline NoArenaScope(napi_env env) { (void) env; }
+  inline void Rewind() {}
+};
+
+template <typename Arguments>
+struct ArenaScopeFor {
+  typedef typename std::conditional<UsesArena<Arguments>::value,
+                                    ArenaScope,
+                                    NoArenaScope>::type type;
+};
+
+// A returned `Promise<T>` must be concluded before it is converted to JS so
+// that it has a `napi_deferred`, and is resolved if it already has a value.
+template <typename T>
+inline napi_status ConcludeReturnValue(napi_env env, const T& value) {
+  (void) env;
+  (void) value;
+  return napi_ok;
+}
+
+template <typename T>
+inline napi_status ConcludeReturnValue(napi_env env, Promise<T>& value) {
+  return value.Conclude(env);
+}
+
+template <typename R>
+struct ReturnValue {
+  template <typename Fn>
+  static inline napi_status
+  Call(napi_env env,
+       typename Fn::Receiver* cc_rcv,
+       typename Fn::Arguments* args,
+       napi_value* result) {
+    R ret = Fn::Call(cc_rcv,
+                     args,
+                     typename MakeIndexSequence<Fn::arg_count>::type());
+    napi_status status = ConcludeReturnValue(env, ret);
+    if (status != napi_ok) return status;
+
+    return Converter<Bare<R>>::ToJS(env, ret, result);
+  }
+};
+
+template <>
+struct ReturnValue<void> {
+  template <typename Fn>
+  static inline napi_status
+  Call(napi_env env,
+       typename Fn::Receiver* cc_rcv,
+       typename Fn::Arguments* args,
+       napi_value* result) {
+    (void) env;
+    Fn::Call(cc_rcv, args, typename MakeIndexSequence<Fn::arg_count>::type());
+    *result = nullptr;
+    return napi_ok;
+  }
+};
+
+// Whether a batch can be given as typed arrays, and whether its results can be
+// returned in a `Float64Array`.
+template <typename T>
+struct IsNumeric
+    : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                   !std::is_same<T, bool>::value> {};
+
+template <typename... T>
+struct AllNumeric;
+
+template <>
+struct AllNumeric<> : std::true_type {};
+
+template <typename T, typename... Rest>
+struct AllNumeric<T, Rest...>
+    : std::integral_constant<bool, IsNumeric<T>::value &&
+                                   AllNumeric<Rest...>::value> {};
+
+template <typename Arguments>
+struct IsNumericTuple;
+
+template <typename... T>
+struct IsNumericTuple<std::tuple<T...>> : AllNumeric<T...> {};
+
+struct TypedArrayColumn {
+  napi_typedarray_type type;
+  const void* data;
+};
+
+// Element `idx` of a typed array whose elements are numbers rather than
+// BigInts. All such elements are exactly representable as a `double`.
+inline double TypedArrayItem(const TypedArrayColumn& column, size_t idx) {
+  switch (column.type) {
+    case napi_int8_array:
+      return static_cast<const int8_t*>(column.data)[idx];
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return static_cast<const uint8_t*>(column.data)[idx];
+    case napi_int16_array:
+      return static_cast<const int16_t*>(column.data)[idx];
+    case napi_uint16_array:
+      return static_cast<const uint16_t*>(column.data)[idx];
+    case napi_int32_array:
+      return static_cast<const int32_t*>(column.data)[idx];
+    case napi_uint32_array:
+      return static_cast<const uint32_t*>(column.data)[idx];
+    case napi_float32_array:
+      return static_cast<const float*>(column.data)[idx];
+    case napi_float64_array:
+      return static_cast<const double*>(column.data)[idx];
+    default:
+      return 0;
+  }
+}
+
+// Reads the arguments of item `item` of a batch given as typed arrays.
+template <size_t idx, size_t count>
+struct ColumnsToNative {
+  template <typename Arguments>
+  static inline void
+  Convert(const TypedArrayColumn* columns, size_t item, Arguments* args) {
+    typedef typename std::tuple_element<idx, Arguments>::type Arg;
+    std::get<idx>(*args) =
+        NumberToNative<Arg>(TypedArrayItem(columns[idx], item));
+    ColumnsToNative<idx + 1, count>::Convert(columns, item, args);
+  }
+};
+
+template <size_t count>
+struct ColumnsToNative<count, count> {
+  template <typename Arguments>
+  static inline void
+  Convert(const TypedArrayColumn* columns, size_t item, Arguments* args) {
+    (void) columns;
+    (void) item;
+    (void) args;
+  }
+};
+
+// Retrieves the arguments of an item of a batch given as an array of argument
+// arrays.
+template <uint32_t optional_mask, typename Arguments>
+struct RowArgs {
+  static const size_t arg_count = std::tuple_size<Arguments>::value;
+  napi_env env;
+  napi_value rows;
+  typename ArenaScopeFor<Arguments>::type* arena_scope;
+  inline napi_status operator()(uint32_t item, Arguments* args) const {
+    napi_value row;
+    napi_value argv[arg_count > 0 ? arg_count : 1];
+
+    // The arguments of the previous item are no longer needed.
+    arena_scope->Rewind();
+
+    napi_status status = napi_get_element(env, rows, item, &row);
+    if (status != napi_ok) return status;
+
+    for (size_t idx = 0; idx < arg_count; idx++) {
+      status = napi_get_element(env, row, idx, &argv[idx]);
+      if (status != napi_ok) return status;
+    }
+
+    return ArgsToNative<optional_mask, 0, arg_count>::Convert(env, argv, args);
+  }
+};
+
+template <typename Arguments>
+struct ColumnArgs {
+  const TypedArrayColumn* columns;
+  inline napi_status operator()(uint32_t item, Arguments* args) const {
+    ColumnsToNative<0, std::tuple_size<Arguments>::value>::Convert(columns,
+                                                                    item,
+                                                                    args);
+    return napi_ok;
+  }
+};
+
+// Calls `Invoker` for each of `count` items whose arguments are retrieved by
+// `fill_args`, and stores the results in an array, in chunks of
+// `kSequenceChunkSize` items, each within a handle scope of its own.
+template <typename Invoker, typename FillArgs>
+inline napi_status
+CallEach(napi_env env,
+         typename Invoker::Receiver* cc_rcv,
+         uint32_t count,
+         const FillArgs& fill_args,
+         napi_value* result,
+         std::false_type numeric_result) {
+  typedef typename Invoker::Return R;
+  typename Invoker::Arguments args;
+  napi_value results = nullptr;
+  napi_status status;
+  (void) numeric_result;
+
+  if (!std::is_void<R>::value) {
+    status = napi_create_array_with_length(env, count, &results);
+    if (status != napi_ok) return status;
+  }
+
+  for (uint32_t start = 0; start < count; start += kSequenceChunkSize) {
+    uint32_t end = (count - start > kSequenceChunkSize
+        ? start + kSequenceChunkSize
+        : count);
+    napi_handle_scope scope;
+
+    status = napi_open_handle_scope(env, &scope);
+    if (status != napi_ok) return status;
+
+    for (uint32_t idx = start; idx < end; idx++) {
+      napi_value js_ret = nullptr;
+
+      status = fill_args(idx, &args);
+      if (status != napi_ok) break;
+
+      status = ReturnValue<R>::template Call<Invoker>(env,
+                                                      cc_rcv,
+                                                      &args,
+                                                      &js_ret);
+      if (status != napi_ok) break;
+
+      if (results != nullptr) {
+        status = napi_set_element(env, results, idx, js_ret);
+        if (status != napi_ok) break;
+      }
+    }
+
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, scope);
+      return status;
+    }
+
+    status = napi_close_handle_scope(env, scope);
+    if (status != napi_ok) return status;
+  }
+
+  *result = results;
+  return napi_ok;
+}
+
+// Numeric results are written straight into the backing store of a
+// `Float64Array`, without creating a JS value for each.
+template <typename Invoker, typename FillArgs>
+inline napi_status
+CallEach(napi_env env,
+         typename Invoker::Receiver* cc_rcv,
+         uint32_t count,
+         const FillArgs& fill_args,
+         napi_value* result,
+         std::true_type numeric_result) {
+  typename Invoker::Arguments args;
+  napi_value buffer;
+  void* data;
+  (void) numeric_result;
+
+  napi_status status =
+      napi_create_arraybuffer(env, count * sizeof(double), &data, &buffer);
+  if (status != napi_ok) return status;
+
+  double* results = static_cast<double*>(data);
+  for (uint32_t idx = 0; idx < count; idx++) {
+    status = fill_args(idx, &args);
+    if (status != napi_ok) return status;
+
+    results[idx] = static_cast<double>(Invoker::Call(
+        cc_rcv,
+        &args,
+        typename MakeIndexSequence<Invoker::arg_count>::type()));
+  }
+
+  return napi_create_typedarray(env,
+                                napi_float64_array,
+                                count,
+                                buffer,
+                                0,
+                                result);
+}
+
+template <typename Invoker>
+inline napi_status
+BatchColumns(napi_env env,
+             typename Invoker::Receiver* cc_rcv,
+             napi_value* argv,
+             napi_value* result,
+             std::false_type numeric_args) {
+  (void) cc_rcv;
+  (void) argv;
+  (void) result;
+  (void) numeric_args;
+  napi_status status = napi_throw_type_error(env,
+      nullptr,
+      "Batches can only be given as typed arrays if all arguments are numeric");
+  return (status == napi_ok ? napi_pending_exception : status);
+}
+
+template <typename Invoker>
+inline napi_status
+BatchColumns(napi_env env,
+             typename Invoker::Receiver* cc_rcv,
+             napi_value* argv,
+             napi_value* result,
+             std::true_type numeric_args) {
+  typedef typename Invoker::Arguments Arguments;
+  TypedArrayColumn columns[Invoker::arg_count > 0 ? Invoker::arg_count : 1];
+  size_t count = 0;
+  napi_status status;
+  (void) numeric_args;
+
+  for (size_t idx = 0; idx < Invoker::arg_count; idx++) {
+    bool is_typedarray;
+    size_t length = 0;
+    void* data;
+
+    status = napi_is_typedarray(env, argv[idx], &is_typedarray);
+    if (status != napi_ok) return status;
+
+    if (is_typedarray) {
+      status = napi_get_typedarray_info(env,
+                                        argv[idx],
+                                        &columns[idx].type,
+                                        &length,
+                                        &data,
+                                        nullptr,
+                                        nullptr);
+      if (status != napi_ok) return status;
+      columns[idx].data = data;
+      if (idx == 0) count = length;
+
+      // Numeric arguments do not convert from BigInts.
+      if (columns[idx].type == napi_bigint64_array ||
+          columns[idx].type == napi_biguint64_array) {
+        status = napi_throw_type_error(env,
+            nullptr,
+            "Numeric arguments cannot be given as BigInt typed arrays");
+        return (status == napi_ok ? napi_pending_exception : status);
+      }
+    }
+
+    if (!is_typedarray || length != count) {
+      status = napi_throw_type_error(env,
+          nullptr,
+          "A batch given as typed arrays needs one typed array per argument, "
+          "all of the same length");
+      return (status == napi_ok ? napi_pending_exception : status);
+    }
+  }
+
+  ColumnArgs<Arguments> fill_args = { columns };
+  return CallEach<Invoker>(
+      env,
+      cc_rcv,
+      static_cast<uint32_t>(count),
+      fill_args,
+      result,
+      IsNumeric<Bare<typename Invoker::Return>>());
+}
+
+}  // end of namespace details
+
+// static
+template <typename Fn, Fn fn, uint32_t optional_mask>
+napi_value Method<Fn, fn, optional_mask>::Call(napi_env env,
+                                               napi_callback_info info) {
+  typedef details::Invoker<Fn, fn> Invoker;
+  typename Invoker::Arguments args;
+  typename Invoker::Receiver* cc_rcv;
+  size_t argc = Invoker::arg_count;
+  napi_value argv[Invoker::arg_count > 0 ? Invoker::arg_count : 1];
+  napi_value js_rcv;
+  napi_value js_ret = nullptr;
+  typename details::ArenaScopeFor<typename Invoker::Arguments>::type
+      arena_scope(env);
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &js_rcv, nullptr));
+  NAPI_CALL(env,
+      (details::ArgsToNative<optional_mask, 0, Invoker::arg_count>::Convert(
+          env,
+          argv,
+          &args)));
+  NAPI_CALL(env, details::RetrieveReceiver(env, js_rcv, &cc_rcv));
+  NAPI_CALL(env,
+      details::ReturnValue<typename Invoker::Return>::template Call<Invoker>(
+          env,
+          cc_rcv,
+          &args,
+          &js_ret));
+  return js_ret;
+}
+
+// static
+template <typename Fn, Fn fn, uint32_t optional_mask>
+napi_value BatchMethod<Fn, fn, optional_mask>::Call(napi_env env,
+                                                    napi_callback_info info) {
+  typedef details::Invoker<Fn, fn> Invoker;
+  typedef typename Invoker::Arguments Arguments;
+  typename Invoker::Receiver* cc_rcv;
+  size_t argc = (Invoker::arg_count > 0 ? Invoker::arg_count : 1);
+  napi_value argv[Invoker::arg_count > 0 ? Invoker::arg_count : 1];
+  napi_value js_rcv;
+  napi_value result = nullptr;
+  bool is_typedarray = false;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &js_rcv, nullptr));
+  NAPI_CALL(env, details::RetrieveReceiver(env, js_rcv, &cc_rcv));
+  if (Invoker::arg_count > 0)
+    NAPI_CALL(env, napi_is_typedarray(env, argv[0], &is_typedarray));
+
+  if (is_typedarray) {
+    NAPI_CALL(env,
+        details::BatchColumns<Invoker>(
+            env,
+            cc_rcv,
+            argv,
+            &result,
+            details::IsNumericTuple<Arguments>()));
+  } else {
+    uint32_t count;
+    typename details::ArenaScopeFor<Arguments>::type arena_scope(env);
+    NAPI_CALL(env, napi_get_array_length(env, argv[0], &count));
+    details::RowArgs<optional_mask, Arguments> fill_args = {
+      env,
+      argv[0],
+      &arena_scope
+    };
+    NAPI_CALL(env,
+        details::CallEach<Invoker>(env,
+                                   cc_rcv,
+                                   count,
+                                   fill_args,
+                                   &result,
+                                   std::false_type()));
+  }
+  return result;
+}
+
+// static
+template <typename Member, Member member, int same_obj_idx>
+napi_value Getter<Member, member, same_obj_idx>::Call(napi_env env,
+                                                      napi_callback_info info) {
+  typedef typename details::MemberOf<Member>::Receiver T;
+  typedef typename details::MemberOf<Member>::Value V;
+  napi_value js_rcv;
+  napi_value result = nullptr;
+  NAPI_CALL(env,
+      napi_get_cb_info(env, info, nullptr, nullptr, &js_rcv, nullptr));
+
+  T* cc_rcv;
+  Wrapping<T>* wrapping;
+  NAPI_CALL(env, Wrapping<T>::Retrieve(env,
+                                       js_rcv,
+                                       &cc_rcv,
+                                       same_obj_idx,
+                                       &result,
+                                       &wrapping));
+  if (result != nullptr) return result;
+
+  NAPI_CALL(env, Converter<V>::ToJS(env, cc_rcv->*member, &result));
+  if (same_obj_idx >= 0)
+    NAPI_CALL(env, wrapping->SetRef(env, same_obj_idx, result));
+  return result;
+}
+
+// static
+template <typename Member, Member member>
+napi_value Setter<Member, member>::Call(napi_env env,
+                                        napi_callback_info info) {
+  typedef typename details::MemberOf<Member>::Receiver T;
+  typedef typename details::MemberOf<Member>::Value V;
+  napi_value js_rcv;
+  napi_value js_new;
+  size_t argc = 1;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &js_new, &js_rcv, nullptr));
+
+  T* cc_rcv;
+  NAPI_CALL(env, Wrapping<T>::Retrieve(env, js_rcv, &cc_rcv));
+
+  NAPI_CALL(env, Converter<V>::ToNative(env, js_new, &(cc_rcv->*member)));
+  return nullptr;
+}
+
+// static
+template <typename T>
+napi_value Accessor<T>::Get(napi_env env, napi_callback_info info) {
+  napi_value js_rcv;
+  napi_value result = nullptr;
+  void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &js_rcv, &data));
+
+  const AttributeDescriptor* attr =
+      static_cast<const AttributeDescriptor*>(data);
+  T* cc_rcv;
+  Wrapping<T>* wrapping;
+  NAPI_CALL(env, Wrapping<T>::Retrieve(env,
+                                       js_rcv,
+                                       &cc_rcv,
+                                       attr->same_obj_idx,
+                                       &result,
+                                       &wrapping));
+  if (result != nullptr) return result;
+
+  NAPI_CALL(env, attr->to_js(env,
+                             reinterpret_cast<const char*>(cc_rcv) +
+                                 attr->offset,
+                             &result));
+  if (attr->same_obj_idx >= 0)
+    NAPI_CALL(env, wrapping->SetRef(env, attr->same_obj_idx, result));
+  return result;
+}
+
+// static
+template <typename T>
+napi_value Accessor<T>::Set(napi_env env, napi_callback_info info) {
+  napi_value js_rcv;
+  napi_value js_new;
+  size_t argc = 1;
+  void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, &js_new, &js_rcv, &data));
+
+  const AttributeDescriptor* attr =
+      static_cast<const AttributeDescriptor*>(data);
+  T* cc_rcv;
+  NAPI_CALL(env, Wrapping<T>::Retrieve(env, js_rcv, &cc_rcv));
+
+  NAPI_CALL(env, attr->to_native(env,
+                                 js_new,
+                                 reinterpret_cast<char*>(cc_rcv) +
+                                     attr->offset));
+  return nullptr;
+}
+
 }  // end of namespace WebIdlNapi
 #endif  // WEBIDL_NAPI_INL_H
@@ -0,0 +1,813 @@
+#include "webidl-napi.h"
+
+#include <stdio.h>
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+// The number of events a `TraceBuffer` holds before it starts overwriting the
+// oldest ones.
+#ifndef WEBIDL_NAPI_TRACE_CAPACITY
+#define WEBIDL_NAPI_TRACE_CAPACITY 65536
+#endif
+
+// The size of the blocks from which an `Arena` allocates. Larger allocations
+// receive a block of their own.
+#ifndef WEBIDL_NAPI_ARENA_BLOCK_SIZE
+#define WEBIDL_NAPI_ARENA_BLOCK_SIZE 16384
+#endif
+
+namespace WebIdlNapi {
+
+// A ring buffer of begin/end events recorded by `TraceScope` for the bindings
+// generated with `--trace`. Each event receives a slot by atomically advancing
+// the write position, so recording never takes a lock. Timestamps are taken
+// from `std::chrono::steady_clock`, so that native code can line up its own
+// spans with the binding calls.
+class TraceBuffer {
+ public:
+  explicit TraceBuffer(size_t capacity);
+  void Record(const TraceEvent& event);
+  std::string ToChromeTraceJSON() const;
+  static uint64_t Now();
+ private:
+  std::unique_ptr<TraceEvent[]> events;
+  size_t capacity;
+  std::atomic<uint64_t> next;
+  uint32_t tid;
+};
+
+// TODO(gabrielschulhof): DOMString should be utf16, not utf8.
+template <>
+napi_status
+Converter<DOMString>::ToNative(napi_env env,
+                               napi_value str,
+                               DOMString* result) {
+  size_t size;
+
+  napi_status status = napi_get_value_string_utf8(env, str, nullptr, 0, &size);
+  if (status != napi_ok) return status;
+
+  result->resize(size + 1);
+  status = napi_get_value_string_utf8(env, str,
+                                      const_cast<char*>(result->c_str()),
+                                      size + 1, &size);
+  if (status != napi_ok) return status;
+
+  return napi_ok;
+}
+
+template <>
+napi_status
+Converter<DOMString>::ToJS(napi_env env,
+                           const DOMString& str,
+                           napi_value* result) {
+  return napi_create_string_utf8(env, str.c_str(), NAPI_AUTO_LENGTH, result);
+}
+
+// Most strings fit into a small first guess at their size, which saves asking
+// for the size separately. UTF-8 output stops short of a character which does
+// not fit entirely, so only a string which leaves at least 4 bytes unused is
+// known to be complete.
+template <>
+napi_status
+Converter<StringView>::ToNative(napi_env env,
+                                napi_value str,
+                                StringView* result) {
+  static const size_t kGuess = 64;
+  Arena* arena;
+  size_t size;
+
+  napi_status status = Arena::GetCurrent(env, &arena);
+  if (status != napi_ok) return status;
+
+  char* chars = static_cast<char*>(arena->Allocate(kGuess, 1));
+  if (chars == nullptr) return napi_generic_failure;
+  status = napi_get_value_string_utf8(env, str, chars, kGuess, &size);
+  if (status != napi_ok) return status;
+
+  if (size + 4 >= kGuess) {
+    status = napi_get_value_string_utf8(env, str, nullptr, 0, &size);
+    if (status != napi_ok) return status;
+
+    if (size >= kGuess) {
+      chars = static_cast<char*>(arena->Allocate(size + 1, 1));
+      if (chars == nullptr) return napi_generic_failure;
+      status = napi_get_value_string_utf8(env, str, chars, size + 1, &size);
+      if (status != napi_ok) return status;
+    }
+  }
+
+  *result = StringView(chars, size);
+  return napi_ok;
+}
+
+template <>
+napi_status
+Converter<StringView>::ToJS(napi_env env,
+                            const StringView& str,
+                            napi_value* result) {
+  return napi_create_string_utf8(env, str.data(), str.size(), result);
+}
+
+napi_status IsConstructCall(napi_env env,
+                            napi_callback_info info,
+                            const char* ifname,
+                            bool* result) {
+  napi_value new_target;
+  bool res = true;
+  napi_status status = napi_get_new_target(env, info, &new_target);
+  if (status != napi_ok) return status;
+
+  if (new_target == nullptr) {
+    status = napi_throw_error(env,
+                              nullptr,
+                              (std::string("Non-construct calls to the `") +
+                                  ifname + "` constructor are not supported.")
+                                  .c_str());
+    if (status != napi_ok) return status;
+    res = false;
+  }
+
+  *result = res;
+  return status;
+}
+
+napi_status PickSignature(napi_env env,
+                          size_t argc,
+                          napi_value* argv,
+                          const SignatureCandidate* sigs,
+                          size_t sig_count,
+                          int* sig_idx) {
+  if (sig_count > 64) return napi_invalid_arg;
+
+  // Bit `n` is set while signature `n` remains a candidate. Advance through
+  // the arguments one at a time and clear the bits of those signatures which do
+  // not accept the type of the argument. Once no candidates remain, the
+  // remaining arguments need not be examined.
+  uint64_t candidates =
+      (sig_count == 64 ? ~static_cast<uint64_t>(0)
+                       : (static_cast<uint64_t>(1) << sig_count) - 1);
+  for (size_t idx = 0; idx < argc && candidates != 0; idx++) {
+    napi_valuetype val_type;
+    napi_status status = napi_typeof(env, argv[idx], &val_type);
+    if (status != napi_ok) return status;
+    for (size_t sig = 0; sig < sig_count; sig++)
+      if (idx >= sigs[sig].arg_count || sigs[sig].arg_types[idx] != val_type)
+        candidates &= ~(static_cast<uint64_t>(1) << sig);
+  }
+
+  // If any signatures are left marked as candidates, return the first one. We
+  // do not touch `sig_idx` if we do not find a candidate, so the caller can set
+  // it to -1 to be informed after this call completes that no candidate was
+  // found.
+  for (size_t sig = 0; sig < sig_count; sig++)
+    if ((candidates & (static_cast<uint64_t>(1) << sig)) != 0) {
+      *sig_idx = static_cast<int>(sig);
+      break;
+    }
+
+  return napi_ok;
+}
+
+napi_status DictionaryToNative(napi_env env,
+                               napi_value val,
+                               void* result,
+                               const DictionaryMember* members,
+                               size_t member_count) {
+  char* base = static_cast<char*>(result);
+  for (size_t idx = 0; idx < member_count; idx++) {
+    napi_value js_member;
+    napi_status status =
+        napi_get_named_property(env, val, members[idx].name, &js_member);
+    if (status != napi_ok) return status;
+
+    status = members[idx].to_native(env,
+                                    js_member,
+                                    base + members[idx].offset);
+    if (status != napi_ok) return status;
+  }
+  return napi_ok;
+}
+
+napi_status DictionaryToJS(napi_env env,
+                           const void* val,
+                           napi_value* result,
+                           const DictionaryMember* members,
+                           size_t member_count) {
+  // Define the properties a few at a time so that we need not allocate an
+  // array of property descriptors as large as the dictionary.
+  static const size_t kBatchSize = 16;
+  napi_property_descriptor props[kBatchSize];
+  const char* base = static_cast<const char*>(val);
+  napi_value ret;
+
+  napi_status status = napi_create_object(env, &ret);
+  if (status != napi_ok) return status;
+
+  for (size_t start = 0; start < member_count; start += kBatchSize) {
+    size_t count = member_count - start;
+    if (count > kBatchSize) count = kBatchSize;
+
+    for (size_t idx = 0; idx < count; idx++) {
+      const DictionaryMember& member = members[start + idx];
+      props[idx] = { member.name, nullptr, nullptr, nullptr, nullptr, nullptr,
+                     napi_enumerable, nullptr };
+      status = member.to_js(env, base + member.offset, &props[idx].value);
+      if (status != napi_ok) return status;
+    }
+
+    status = napi_define_properties(env, ret, count, props);
+    if (status != napi_ok) return status;
+  }
+
+  *result = ret;
+  return napi_ok;
+}
+
+static void ReleaseColumn(napi_env env, void* data, void* hint) {
+  (void) env;
+  (void) data;
+  delete static_cast<std::shared_ptr<char>*>(hint);
+}
+
+// The array buffer shares ownership of the column, unless external array
+// buffers are not allowed, in which case it receives a copy.
+static napi_status ColumnToArrayBuffer(napi_env env,
+                                       const std::shared_ptr<char>& column,
+                                       size_t byte_length,
+                                       napi_value* result) {
+  napi_status status;
+  void* data;
+
+#ifndef NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+  std::shared_ptr<char>* owner = new std::shared_ptr<char>(column);
+  status = napi_create_external_arraybuffer(env,
+                                            column.get(),
+                                            byte_length,
+                                            ReleaseColumn,
+                                            owner,
+                                            result);
+  if (status == napi_ok) return napi_ok;
+
+  delete owner;
+  if (status != napi_no_external_buffers_allowed) return status;
+#endif  // NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED
+
+  status = napi_create_arraybuffer(env, byte_length, &data, result);
+  if (status != napi_ok) return status;
+
+  if (byte_length > 0) memcpy(data, column.get(), byte_length);
+  return napi_ok;
+}
+
+napi_status ColumnarToJS(napi_env env,
+                         size_t length,
+                         const std::shared_ptr<char>* columns,
+                         const ColumnarMember* members,
+                         size_t member_count,
+                         napi_value* result) {
+  napi_value ret;
+  napi_value js_length;
+
+  napi_status status = napi_create_object(env, &ret);
+  if (status != napi_ok) return status;
+
+  status = napi_create_double(env, static_cast<double>(length), &js_length);
+  if (status != napi_ok) return status;
+
+  status = napi_set_named_property(env, ret, "length", js_length);
+  if (status != napi_ok) return status;
+
+  for (size_t idx = 0; idx < member_count; idx++) {
+    napi_value buffer;
+    napi_value column;
+
+    if (members[idx].shared) {
+      status = ColumnToArrayBuffer(env,
+                                   columns[idx],
+                                   length * members[idx].size,
+                                   &buffer);
+      if (status != napi_ok) return status;
+    } else {
+      void* data;
+
+      status = napi_create_arraybuffer(env,
+                                       length * members[idx].element_size,
+                                       &data,
+                                       &buffer);
+      if (status != napi_ok) return status;
+
+      members[idx].to_elements(columns[idx].get(), length, data);
+    }
+
+    status = napi_create_typedarray(env,
+                                    members[idx].type,
+                                    length,
+                                    buffer,
+                                    0,
+                                    &column);
+    if (status != napi_ok) return status;
+
+    status = napi_set_named_property(env, ret, members[idx].name, column);
+    if (status != napi_ok) return status;
+  }
+
+  *result = ret;
+  return napi_ok;
+}
+
+// A typed array of the member's own type is copied as a whole, or element by
+// element if the native type of the member has a different layout. Anything
+// else is converted one element at a time, in chunks, each within a handle
+// scope of its own.
+static napi_status ColumnToNative(napi_env env,
+                                  napi_value js_column,
+                                  const ColumnarMember& member,
+                                  size_t length,
+                                  char* column) {
+  bool is_typedarray;
+  napi_status status = napi_is_typedarray(env, js_column, &is_typedarray);
+  if (status != napi_ok) return status;
+
+  if (is_typedarray) {
+    napi_typedarray_type type;
+    size_t js_length;
+    void* data;
+
+    status = napi_get_typedarray_info(env,
+                                      js_column,
+                                      &type,
+                                      &js_length,
+                                      &data,
+                                      nullptr,
+                                      nullptr);
+    if (status != napi_ok) return status;
+
+    if (type == member.type && js_length == length) {
+      if (!member.shared)
+        member.from_elements(data, length, column);
+      else if (length > 0)
+        memcpy(column, data, length * member.size);
+      return napi_ok;
+    }
+  }
+
+  for (size_t start = 0; start < length;
+       start += details::kSequenceChunkSize) {
+    size_t end = std::min(length, start + details::kSequenceChunkSize);
+    napi_handle_scope scope;
+
+    status = napi_open_handle_scope(env, &scope);
+    if (status != napi_ok) return status;
+
+    for (size_t idx = start; idx < end; idx++) {
+      napi_value item;
+
+      status = napi_get_element(env,
+                                js_column,
+                                static_cast<uint32_t>(idx),
+                                &item);
+      if (status != napi_ok) break;
+
+      status = member.to_native(env, item, column + idx * member.size);
+      if (status != napi_ok) break;
+    }
+
+    if (status != napi_ok) {
+      napi_close_handle_scope(env, scope);
+      return status;
+    }
+
+    status = napi_close_handle_scope(env, scope);
+    if (status != napi_ok) return status;
+  }
+
+  return napi_ok;
+}
+
+// The number of items in a column, which is either a typed array or an array.
+static napi_status ColumnLength(napi_env env,
+                                napi_value js_column,
+                                size_t* result) {
+  bool is_typedarray;
+  napi_status status = napi_is_typedarray(env, js_column, &is_typedarray);
+  if (status != napi_ok) return status;
+
+  if (is_typedarray) {
+    return napi_get_typedarray_info(env,
+                                    js_column,
+                                    nullptr,
+                                    result,
+                                    nullptr,
+                                    nullptr,
+                                    nullptr);
+  }
+
+  uint32_t length;
+  status = napi_get_array_length(env, js_column, &length);
+  if (status != napi_ok) return status;
+
+  *result = length;
+  return napi_ok;
+}
+
+// The `length` of the object is only trusted once each column is found to
+// hold that many items, so that nothing is allocated on behalf of a `length`
+// which the columns do not back.
+napi_status ColumnarToNative(napi_env env,
+                             napi_value val,
+                             const ColumnarMember* members,
+                             size_t member_count,
+                             size_t* length,
+                             std::vector<std::shared_ptr<char>>* columns) {
+  std::vector<std::shared_ptr<char>> new_columns;
+  std::vector<napi_value> js_columns(member_count);
+  napi_value js_length;
+  int64_t new_length;
+
+  napi_status status =
+      napi_get_named_property(env, val, "length", &js_length);
+  if (status != napi_ok) return status;
+
+  status = napi_get_value_int64(env, js_length, &new_length);
+  if (status != napi_ok) return status;
+  if (new_length < 0 || new_length > UINT32_MAX) return napi_invalid_arg;
+
+  for (size_t idx = 0; idx < member_count; idx++) {
+    size_t column_length;
+
+    status = napi_get_named_property(env,
+                                     val,
+                                     members[idx].name,
+                                     &js_columns[idx]);
+    if (status != napi_ok) return status;
+
+    status = ColumnLength(env, js_columns[idx], &column_length);
+    if (status != napi_ok) return status;
+    if (column_length != static_cast<size_t>(new_length))
+      return napi_invalid_arg;
+  }
+
+  new_columns.reserve(member_count);
+  for (size_t idx = 0; idx < member_count; idx++) {
+    char* column = new (std::nothrow) char[new_length * members[idx].size]();
+    if (column == nullptr) return napi_generic_failure;
+
+    new_columns.emplace_back(column, std::default_delete<char[]>());
+    status = ColumnToNative(env,
+                            js_columns[idx],
+                            members[idx],
+                            static_cast<size_t>(new_length),
+                            column);
+    if (status != napi_ok) return status;
+  }
+
+  *length = static_cast<size_t>(new_length);
+  columns->swap(new_columns);
+  return napi_ok;
+}
+
+TraceBuffer::TraceBuffer(size_t new_capacity):
+    events(new TraceEvent[new_capacity]), capacity(new_capacity), next(0) {
+  // An env is only ever used from the thread on which it was created.
+  tid = static_cast<uint32_t>(
+      std::hash<std::thread::id>()(std::this_thread::get_id()) & 0x7fffffff);
+}
+
+void TraceBuffer::Record(const TraceEvent& event) {
+  uint64_t idx = next.fetch_add(1, std::memory_order_relaxed);
+  events[idx % capacity] = event;
+}
+
+// static
+uint64_t TraceBuffer::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string TraceBuffer::ToChromeTraceJSON() const {
+#if defined(_WIN32)
+  int pid = _getpid();
+#else
+  int pid = getpid();
+#endif
+  uint64_t end = next.load(std::memory_order_acquire);
+  uint64_t start = (end > capacity ? end - capacity : 0);
+  std::string json("{\"traceEvents\":[");
+  char buf[128];
+
+  for (uint64_t idx = start; idx < end; idx++) {
+    const TraceEvent& event = events[idx % capacity];
+    if (idx > start) json += ',';
+    json += "{\"name\":\"";
+    json += event.ifname;
+    json += '.';
+    json += event.name;
+    snprintf(buf, sizeof(buf),
+             "\",\"cat\":\"webidl-napi\",\"ph\":\"%c\",\"ts\":%.3f,"
+             "\"pid\":%d,\"tid\":%u",
+             event.begin ? 'B' : 'E',
+             static_cast<double>(event.timestamp_ns) / 1000.0,
+             pid,
+             tid);
+    json += buf;
+    if (event.begin) {
+      snprintf(buf, sizeof(buf), ",\"args\":{\"argc\":%u,\"argSizes\":[",
+               event.argc);
+      json += buf;
+      for (uint32_t arg = 0;
+           arg < event.argc && arg < TraceEvent::kMaxTracedArgs;
+           arg++) {
+        snprintf(buf, sizeof(buf), "%s%u", arg > 0 ? "," : "",
+                 event.arg_sizes[arg]);
+        json += buf;
+      }
+      json += "]}";
+    }
+    json += '}';
+  }
+
+  json += "]}";
+  return json;
+}
+
+TraceScope::TraceScope(napi_env env,
+                       napi_callback_info info,
+                       const char* ifname,
+                       const char* name) {
+  InstanceData* idata;
+  napi_value argv[TraceEvent::kMaxTracedArgs];
+  size_t argc = TraceEvent::kMaxTracedArgs;
+
+  event.ifname = ifname;
+  event.name = name;
+  event.begin = true;
+  event.argc = 0;
+
+  // Tracing must not cause a binding to fail, so we record nothing if we
+  // cannot retrieve the information we need.
+  if (InstanceData::GetCurrent(env, &idata) != napi_ok) return;
+  if (napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr) != napi_ok)
+    return;
+
+  event.argc = static_cast<uint32_t>(argc);
+  for (size_t idx = 0;
+       idx < argc && idx < TraceEvent::kMaxTracedArgs;
+       idx++) {
+    napi_valuetype val_type;
+    bool is_array = false;
+    size_t size = 0;
+
+    if (napi_typeof(env, argv[idx], &val_type) == napi_ok) {
+      if (val_type == napi_string) {
+        napi_get_value_string_utf8(env, argv[idx], nullptr, 0, &size);
+      } else if (val_type == napi_object &&
+                 napi_is_array(env, argv[idx], &is_array) == napi_ok &&
+                 is_array) {
+        uint32_t length = 0;
+        napi_get_array_length(env, argv[idx], &length);
+        size = length;
+      } else if (val_type == napi_object &&
+                 napi_is_typedarray(env, argv[idx], &is_array) == napi_ok &&
+                 is_array) {
+        napi_get_typedarray_info(env, argv[idx], nullptr, &size, nullptr,
+                                 nullptr, nullptr);
+      }
+    }
+    event.arg_sizes[idx] = static_cast<uint32_t>(size);
+  }
+
+  buffer = idata->GetTraceBuffer();
+  event.timestamp_ns = TraceBuffer::Now();
+  buffer->Record(event);
+}
+
+TraceScope::~TraceScope() {
+  if (buffer == nullptr) return;
+  event.begin = false;
+  event.timestamp_ns = TraceBuffer::Now();
+  buffer->Record(event);
+}
+
+napi_status GetChromeTrace(napi_env env, std::string* result) {
+  InstanceData* idata;
+  napi_status status = InstanceData::GetCurrent(env, &idata);
+  if (status != napi_ok) return status;
+
+  *result = idata->GetTraceBuffer()->ToChromeTraceJSON();
+  return napi_ok;
+}
+
+Arena::Arena() {}
+
+Arena::~Arena() {
+  for (const Block& block: blocks) delete[] block.data;
+}
+
+// static
+napi_status Arena::GetCurrent(napi_env env, Arena** result) {
+  InstanceData* idata;
+  napi_status status = InstanceData::GetCurrent(env, &idata);
+  if (status != napi_ok) return status;
+
+  *result = idata->GetArena();
+  return napi_ok;
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  // Try the current block, then the blocks after it, which are left over from
+  // earlier calls. If none of them has room, insert a new block after the
+  // current one.
+  for (size_t idx = current; idx < blocks.size(); idx++) {
+    size_t start = (idx == current ? offset : 0);
+    uintptr_t address = reinterpret_cast<uintptr_t>(blocks[idx].data) + start;
+    size_t padding = (alignment - address % alignment) % alignment;
+    if (start + padding + size <= blocks[idx].size) {
+      current = idx;
+      offset = start + padding + size;
+      return blocks[idx].data + start + padding;
+    }
+  }
+
+  if (size > SIZE_MAX - alignment) return nullptr;
+  Block block;
+  block.size = std::max(static_cast<size_t>(WEBIDL_NAPI_ARENA_BLOCK_SIZE),
+                        size + alignment);
+  block.data = new (std::nothrow) char[block.size];
+  if (block.data == nullptr) return nullptr;
+  size_t insert_at = (blocks.empty() ? 0 : current + 1);
+  blocks.insert(blocks.begin() + insert_at, block);
+  current = insert_at;
+
+  uintptr_t address = reinterpret_cast<uintptr_t>(block.data);
+  size_t padding = (alignment - address % alignment) % alignment;
+  offset = padding + size;
+  return block.data + padding;
+}
+
+Arena::Mark Arena::GetMark() const {
+  Mark mark = { current, offset };
+  return mark;
+}
+
+void Arena::Rewind(const Mark& mark) {
+  current = mark.block;
+  offset = mark.offset;
+}
+
+// Rewinds the arena to its start and frees the blocks which are larger than the
+// standard size.
+void Arena::Release() {
+  size_t kept = 0;
+  for (const Block& block: blocks) {
+    if (block.size > WEBIDL_NAPI_ARENA_BLOCK_SIZE)
+      delete[] block.data;
+    else
+      blocks[kept++] = block;
+  }
+  blocks.resize(kept);
+  current = 0;
+  offset = 0;
+}
+
+size_t Arena::InUse() const {
+  size_t result = offset;
+  for (size_t idx = 0; idx < current && idx < blocks.size(); idx++)
+    result += blocks[idx].size;
+  return result;
+}
+
+size_t Arena::Capacity() const {
+  size_t result = 0;
+  for (const Block& block: blocks) result += block.size;
+  return result;
+}
+
+ArenaScope::ArenaScope(napi_env env) {
+  // If there is no arena, the converters that need one fail on their own.
+  if (Arena::GetCurrent(env, &arena) != napi_ok) {
+    arena = nullptr;
+    return;
+  }
+  mark = arena->GetMark();
+  arena->scope_depth++;
+}
+
+ArenaScope::~ArenaScope() {
+  if (arena == nullptr) return;
+  if (--arena->scope_depth == 0) {
+    arena->Release();
+  } else {
+    arena->Rewind(mark);
+  }
+}
+
+void ArenaScope::Rewind() {
+  if (arena != nullptr) arena->Rewind(mark);
+}
+
+// We assume that we are in control of the instance data for this add-on. Even
+// so, we also assume that there may be multiple generated files bundled into
+// this add-on, each of which uses `InstanceData` to manage its state. Thus,
+// if no data is set, we set a new instance, and if one is already set, we
+// assume it's an instance of `InstanceData` and use that.
+// static
+napi_status
+InstanceData::GetCurrent(napi_env env, InstanceData** result) {
+  void* data = nullptr;
+
+  napi_status status = napi_get_instance_data(env, &data);
+  if (status != napi_ok) return status;
+
+  if (data == nullptr) {
+    InstanceData* new_data = new InstanceData;
+
+    data = static_cast<void*>(new_data);
+    status = napi_set_instance_data(env, data, DestroyInstanceData, nullptr);
+    if (status != napi_ok) {
+      delete new_data;
+      return status;
+    }
+  }
+
+  *result = static_cast<InstanceData*>(data);
+  return napi_ok;
+}
+
+static bool ConstructorNameLess(const std::pair<const char*, napi_ref>& ctor,
+                                const char* name) {
+  return std::less<const char*>()(ctor.first, name);
+}
+
+void InstanceData::AddConstructor(const char* name, napi_ref ctor) {
+  auto it = std::lower_bound(ctors.begin(), ctors.end(), name,
+                             ConstructorNameLess);
+  if (it != ctors.end() && it->first == name)
+    it->second = ctor;
+  else
+    ctors.insert(it, std::make_pair(name, ctor));
+}
+
+void
+InstanceData::SetData(void* new_data, napi_finalize fin_cb, void* new_hint) {
+  data = new_data;
+  cb = fin_cb;
+  hint = new_hint;
+}
+
+void* InstanceData::GetData() {
+  return data;
+}
+
+TraceBuffer* InstanceData::GetTraceBuffer() {
+  if (trace_buffer == nullptr)
+    trace_buffer = new TraceBuffer(WEBIDL_NAPI_TRACE_CAPACITY);
+  return trace_buffer;
+}
+
+Arena* InstanceData::GetArena() {
+  if (arena == nullptr) arena = new Arena;
+  return arena;
+}
+
+// static
+void
+InstanceData::DestroyInstanceData(napi_env env, void* data, void* hint) {
+  (void) hint;
+  InstanceData* idata = static_cast<InstanceData*>(data);
+  idata->Destroy(env);
+  delete idata;
+}
+
+void InstanceData::Destroy(napi_env env) {
+  delete trace_buffer;
+  trace_buffer = nullptr;
+  delete arena;
+  arena = nullptr;
+
+  // Keep going if a reference cannot be deleted, so that the rest of the
+  // instance data is still released.
+  for (std::pair<const char*, napi_ref> ctor: ctors) {
+    napi_delete_reference(env, ctor.second);
+  }
+  ctors.clear();
+
+  if (data != nullptr && cb != nullptr) cb(env, data, hint);
+}
+
+napi_ref InstanceData::GetConstructor(const char* name) {
+  auto it = std::lower_bound(ctors.begin(), ctors.end(), name,
+                             ConstructorNameLess);
+  return ((it != ctors.end() && it->first == name) ? it->second : nullptr);
+}
+
+}  // end of namespace WebIdlNapi
@@ -1,10 +1,17 @@
 #ifndef WEBIDL_NAPI_H
 #define WEBIDL_NAPI_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
-#include <string>
-#include <map>
+#include <cmath>
+#include <initializer_list>
 #include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // TODO(gabrielschulhof): Once we no longer support Node.js 10, we can
@@ -57,11 +64,6 @@
 #define NAPI_CALL_RETURN_VOID(env, the_call)                             \
   NAPI_CALL_BASE(env, the_call, NAPI_RETVAL_NOTHING)
 
-struct webidl_sig {
-  bool candidate;
-  std::vector<napi_valuetype> sig;
-};
-
 using DOMString = std::string;
 using USVString = std::string;
 using object = napi_value;
@@ -69,17 +71,68 @@ using bool_t = bool;
 
 namespace WebIdlNapi {
 
-static napi_status
-PickSignature(napi_env env,
-              size_t argc,
-              napi_value* argv,
-              std::vector<webidl_sig> sigs,
-              int* sig_idx);
+// One of the signatures of an overloaded operation, as the types of its
+// arguments. The generated code passes these to `PickSignature()` in static
+// tables.
+struct SignatureCandidate {
+  size_t arg_count;
+  const napi_valuetype* arg_types;
+};
+
+// Sets `*sig_idx` to the index of the first of `sig_count` (at most 64)
+// signatures whose argument types match the types of `argv`, and leaves it
+// untouched if none do.
+napi_status PickSignature(napi_env env,
+                          size_t argc,
+                          napi_value* argv,
+                          const SignatureCandidate* sigs,
+                          size_t sig_count,
+                          int* sig_idx);
+
+napi_status IsConstructCall(napi_env env,
+                            napi_callback_info info,
+                            const char* ifname,
+                            bool* result);
 
-static napi_status IsConstructCall(napi_env env,
-                                   napi_callback_info info,
-                                   const char* ifname,
-                                   bool* result);
+// In compact mode, a dictionary is described by a table of these entries, one
+// per member, and converted by `DictionaryToNative()` and `DictionaryToJS()`.
+struct DictionaryMember {
+  const char* name;
+  size_t offset;
+  napi_status (*to_native)(napi_env env, napi_value val, void* result);
+  napi_status (*to_js)(napi_env env, const void* val, napi_value* result);
+};
+
+// In compact mode, an attribute is described by one of these, passed to the
+// generic `Accessor<T>::Get()` and `Accessor<T>::Set()` via the `data` field of
+// its property descriptor. `to_native` is `nullptr` for read-only attributes,
+// and `same_obj_idx` is -1 for attributes that are not `[SameObject]`.
+struct AttributeDescriptor {
+  size_t offset;
+  napi_status (*to_native)(napi_env env, napi_value val, void* result);
+  napi_status (*to_js)(napi_env env, const void* val, napi_value* result);
+  int same_obj_idx;
+};
+
+napi_status DictionaryToNative(napi_env env,
+                               napi_value val,
+                               void* result,
+                               const DictionaryMember* members,
+                               size_t member_count);
+
+napi_status DictionaryToJS(napi_env env,
+                           const void* val,
+                           napi_value* result,
+                           const DictionaryMember* members,
+                           size_t member_count);
+
+// Type-erased entry points into `ConverterType::ToNative()` and
+// `ConverterType::ToJS()` for use in the tables above.
+template <typename ConverterType, typename T>
+napi_status ConvertToNative(napi_env env, napi_value val, void* result);
+
+template <typename ConverterType, typename T>
+napi_status ConvertToJS(napi_env env, const void* val, napi_value* result);
 
 template <typename T>
 class Converter {
@@ -132,6 +185,298 @@ class FrozenArray : public std::vector<T> {
   ToNative(napi_env env, napi_value val, FrozenArray<T>* result);
 };
 
+// A ring buffer of `TraceEvent`s, defined in webidl-napi.cc.
+class TraceBuffer;
+
+struct TraceEvent {
+  static const size_t kMaxTracedArgs = 4;
+  const char* ifname;
+  const char* name;
+  uint64_t timestamp_ns;
+  bool begin;
+  uint32_t argc;
+  uint32_t arg_sizes[kMaxTracedArgs];
+};
+
+// Records a begin event for the binding `ifname.name` when constructed, and the
+// corresponding end event when destroyed. The event records the number of
+// arguments and, for up to `TraceEvent::kMaxTracedArgs` arguments, the length
+// of the argument if it is a string, an array, or a typed array.
+class TraceScope {
+ public:
+  TraceScope(napi_env env,
+             napi_callback_info info,
+             const char* ifname,
+             const char* name);
+  ~TraceScope();
+ private:
+  TraceBuffer* buffer = nullptr;
+  TraceEvent event;
+};
+
+// Retrieves the events recorded for `env` in the Chrome trace event format.
+napi_status GetChromeTrace(napi_env env, std::string* result);
+
+// The native form of `record<K, V>`: the key/value pairs of the own enumerable
+// string-keyed properties of an object, in property order.
+template <typename K, typename V>
+class record : public std::vector<std::pair<K, V>> {
+ public:
+  static napi_status
+  ToJS(napi_env env, const record<K, V>& rec, napi_value* result);
+  static napi_status
+  ToNative(napi_env env, napi_value val, record<K, V>* result);
+};
+
+// A 64-bit integer which converts to and from a BigInt rather than a number,
+// so that it does not lose precision, for `long long` and `unsigned long long`
+// values marked `[BigInt]`. Converting a BigInt which does not fit fails with
+// `napi_invalid_arg`, and converting anything other than a BigInt fails with
+// `napi_bigint_expected`. It has the layout of `T`, so a `BigInt64Array` or a
+// `BigUint64Array` converts to a `sequence<>` of them in bulk, and to a
+// `SequenceView<>` of them in place.
+template <typename T>
+class BigInt {
+ public:
+  BigInt();
+  BigInt(T value);
+  operator T() const;
+ private:
+  T value;
+};
+
+typedef BigInt<int64_t> bigint64_t;
+typedef BigInt<uint64_t> biguint64_t;
+
+// A bump allocator for storage which does not outlive a binding call, such as
+// the characters of a `StringView` argument. Memory is handed out from blocks
+// of `WEBIDL_NAPI_ARENA_BLOCK_SIZE` bytes (by default 16384) which are kept for
+// reuse, and is reclaimed all at once when the `ArenaScope` of the call ends.
+// Blocks made larger than that for a single allocation are freed when the
+// outermost scope ends, so that one large argument does not pin its memory for
+// the lifetime of the environment. `Allocate()` returns `nullptr` if it runs
+// out of memory.
+class Arena {
+ public:
+  struct Mark {
+    size_t block;
+    size_t offset;
+  };
+  Arena();
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  static napi_status GetCurrent(napi_env env, Arena** result);
+  void* Allocate(size_t size, size_t alignment);
+  Mark GetMark() const;
+  void Rewind(const Mark& mark);
+  // The number of bytes between the start of the arena and the current mark.
+  size_t InUse() const;
+  // The number of bytes held by the blocks of the arena.
+  size_t Capacity() const;
+ private:
+  friend class ArenaScope;
+  void Release();
+  struct Block {
+    char* data;
+    size_t size;
+  };
+  std::vector<Block> blocks;
+  size_t current = 0;
+  size_t offset = 0;
+  size_t scope_depth = 0;
+};
+
+// Rewinds the arena of `env` to where it was when the scope was created once
+// the scope ends, or when `Rewind()` is called. The outermost scope rewinds the
+// arena to its start, which also reclaims anything allocated outside of a
+// scope. `Method<>` and `BatchMethod<>` open one if the native signature takes
+// a `StringView` or a `SequenceView<T>`.
+class ArenaScope {
+ public:
+  explicit ArenaScope(napi_env env);
+  ~ArenaScope();
+  void Rewind();
+ private:
+  Arena* arena = nullptr;
+  Arena::Mark mark;
+};
+
+// A string whose characters are not owned. Converted from JS, the characters
+// are stored, NUL-terminated, in the arena of the call, so the view must not
+// be kept once the call returns.
+class StringView {
+ public:
+  StringView();
+  StringView(const char* chars, size_t length);
+  StringView(const std::string& str);
+  const char* data() const;
+  size_t size() const;
+  bool empty() const;
+  const char* begin() const;
+  const char* end() const;
+ private:
+  const char* chars;
+  size_t length;
+};
+
+// The counterpart of `sequence<T>` which does not own its items. Converted from
+// JS, it refers to the backing store of a typed array whose elements are of
+// type `T`, or to items converted into the arena of the call. Either way it
+// must not be kept once the call returns. `T` must be trivially destructible,
+// since the arena does not run destructors.
+template <typename T>
+class SequenceView {
+ public:
+  SequenceView();
+  SequenceView(const T* items, size_t count);
+  const T* data() const;
+  size_t size() const;
+  bool empty() const;
+  const T* begin() const;
+  const T* end() const;
+  const T& operator[](size_t idx) const;
+  static napi_status
+  ToJS(napi_env env, const SequenceView<T>& seq, napi_value* result);
+  static napi_status
+  ToNative(napi_env env, napi_value val, SequenceView<T>* result);
+ private:
+  const T* items;
+  size_t count;
+};
+
+// A dictionary argument whose members are converted on first access rather
+// than all at once, for dictionaries marked `[LazyView]`. It holds on to the
+// JS object, so it must not be kept once the call returns. `Get()` converts a
+// member into a copy of `T` held by the view, and returns the same member
+// without converting it again on later calls, except for members past the
+// 64th, which are converted on each call. `GetView()` returns a view of a
+// member which is itself a dictionary marked `[LazyView]`, without converting
+// any of its members. Both return the status of the conversion. If it fails,
+// they throw, so the native method should return right away, and whatever it
+// returns is discarded.
+template <typename T>
+class DictionaryView {
+ public:
+  DictionaryView();
+  template <typename V>
+  napi_status Get(V T::* member, const V** result) const;
+  template <typename V>
+  napi_status GetView(V T::* member, DictionaryView<V>* result) const;
+  napi_value GetObject() const;
+  static napi_status
+  ToJS(napi_env env, const DictionaryView<T>& view, napi_value* result);
+  static napi_status
+  ToNative(napi_env env, napi_value val, DictionaryView<T>* result);
+  // Defined by the generated code for each dictionary marked `[LazyView]`.
+  static const DictionaryMember* Members(size_t* count);
+ private:
+  napi_status FindMember(size_t offset,
+                         const DictionaryMember** member,
+                         size_t* idx) const;
+  napi_status Throw(napi_status status) const;
+  napi_env env = nullptr;
+  napi_value object = nullptr;
+  mutable T cache;
+  mutable uint64_t converted = 0;
+};
+
+// Describes a member of a dictionary marked `[Columnar]` to
+// `ColumnarSequence<>`: where it is in the dictionary, the size of its native
+// type, and the type of the typed array that holds its column in JS, which
+// follows the IDL type of the member. If the elements of that typed array have
+// the layout of the native type, the column is `shared` with the typed array.
+// Otherwise, `to_elements` and `from_elements` copy it to and from the
+// elements, of `element_size` bytes each.
+struct ColumnarMember {
+  const char* name;
+  size_t offset;
+  size_t size;
+  napi_typedarray_type type;
+  size_t element_size;
+  bool shared;
+  napi_status (*to_native)(napi_env env, napi_value val, void* result);
+  void (*to_elements)(const void* column, size_t length, void* elements);
+  void (*from_elements)(const void* elements, size_t length, void* column);
+};
+
+// Copies a column of native `V` to and from the elements `E` of the typed
+// array which holds it in JS, converting elements which are numbers to
+// integers the way `Converter<V>` converts numbers.
+template <typename V, typename E>
+struct ColumnElements {
+  static const bool shared;
+  static void ToElements(const void* column, size_t length, void* elements);
+  static void FromElements(const void* elements, size_t length, void* column);
+};
+
+// The counterpart of `sequence<T>` for a dictionary `T` marked `[Columnar]`,
+// whose members are all numeric. The items are stored as one column per member
+// rather than as an array of `T`, and are exposed to JS as an object with a
+// `length` and, for each member, a typed array over its column, which refers
+// to the native memory if the runtime allows external array buffers and holds
+// a copy of it otherwise. Columns whose native type has the layout of the
+// elements of their typed array are shared with it, so they must not be
+// written once converted to JS. The typed array follows the IDL type of the
+// member, and only members marked `[BigInt]` are exposed as `BigInt64Array`s
+// or `BigUint64Array`s.
+template <typename T>
+class ColumnarSequence {
+ public:
+  ColumnarSequence();
+  // Creates `length` items, all zero. If the columns cannot be allocated,
+  // `Column()` returns `nullptr` and converting to JS fails with
+  // `napi_generic_failure`.
+  explicit ColumnarSequence(size_t length);
+  size_t size() const;
+  // The column holding `member` of each item, or `nullptr` if `member` is not
+  // in the dictionary.
+  template <typename V>
+  V* Column(V T::* member);
+  template <typename V>
+  const V* Column(V T::* member) const;
+  static napi_status
+  ToJS(napi_env env, const ColumnarSequence<T>& seq, napi_value* result);
+  static napi_status
+  ToNative(napi_env env, napi_value val, ColumnarSequence<T>* result);
+  // Defined by the generated code for each dictionary marked `[Columnar]`.
+  static const ColumnarMember* Members(size_t* count);
+ private:
+  template <typename V>
+  void* FindColumn(V T::* member) const;
+  size_t length = 0;
+  std::vector<std::shared_ptr<char>> columns;
+};
+
+// The native types of the return value and the arguments of a member function
+// or a static member function `Fn`, or the native type of a data member `Fn`.
+// The bindings deduce their converters from these, so the generated code
+// checks with `BindsAs<>` that those bound to values marked `[BigInt]` match.
+template <typename Fn>
+struct NativeTypes;
+
+// Whether a native `Native` converts like the native type `Idl` generated for
+// an IDL type, which is the case if they are the same type, or if `Native` is
+// a `SequenceView<>` of items that convert like those of the `sequence<>`.
+template <typename Native, typename Idl>
+struct BindsAs;
+
+napi_status ColumnarToJS(napi_env env,
+                         size_t length,
+                         const std::shared_ptr<char>* columns,
+                         const ColumnarMember* members,
+                         size_t member_count,
+                         napi_value* result);
+
+// Reads the columns from an object of the form produced by `ColumnarToJS()`,
+// whose columns may also be plain arrays or typed arrays of other types.
+napi_status ColumnarToNative(napi_env env,
+                             napi_value val,
+                             const ColumnarMember* members,
+                             size_t member_count,
+                             size_t* length,
+                             std::vector<std::shared_ptr<char>>* columns);
+
 class InstanceData {
  public:
   static napi_status GetCurrent(napi_env env, InstanceData** result);
@@ -139,13 +484,18 @@ class InstanceData {
   napi_ref GetConstructor(const char* name);
   void SetData(void* data, napi_finalize fin_cb, void* hint);
   void* GetData();
+  TraceBuffer* GetTraceBuffer();
+  Arena* GetArena();
  private:
   static void DestroyInstanceData(napi_env env, void* raw, void* hint);
   void Destroy(napi_env env);
-  std::map<const char*, napi_ref> ctors;
+  // Sorted by name pointer.
+  std::vector<std::pair<const char*, napi_ref>> ctors;
   void* data = nullptr;
   void* hint = nullptr;
   napi_finalize cb = nullptr;
+  TraceBuffer* trace_buffer = nullptr;
+  Arena* arena = nullptr;
 };
 
 template <typename T>
@@ -168,6 +518,153 @@ class Wrapping {
   std::vector<napi_ref> refs;
 };
 
+// Defined in webidl-napi.cc.
+template <>
+napi_status Converter<DOMString>::ToNative(napi_env env,
+                                           napi_value value,
+                                           DOMString* result);
+template <>
+napi_status Converter<DOMString>::ToJS(napi_env env,
+                                       const DOMString& value,
+                                       napi_value* result);
+template <>
+napi_status Converter<StringView>::ToNative(napi_env env,
+                                            napi_value value,
+                                            StringView* result);
+template <>
+napi_status Converter<StringView>::ToJS(napi_env env,
+                                        const StringView& value,
+                                        napi_value* result);
+
+// Generic types convert via their own static `ToNative()` and `ToJS()`. These
+// specializations make them available via `Converter<T>` as well, so that the
+// templates below can pick a converter for any type they deduce.
+template <typename T>
+class Converter<sequence<T>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              sequence<T>* result);
+  static napi_status ToJS(napi_env env,
+                          const sequence<T>& value,
+                          napi_value* result);
+};
+
+template <typename T>
+class Converter<FrozenArray<T>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              FrozenArray<T>* result);
+  static napi_status ToJS(napi_env env,
+                          const FrozenArray<T>& value,
+                          napi_value* result);
+};
+
+template <typename T>
+class Converter<SequenceView<T>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              SequenceView<T>* result);
+  static napi_status ToJS(napi_env env,
+                          const SequenceView<T>& value,
+                          napi_value* result);
+};
+
+template <typename T>
+class Converter<DictionaryView<T>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              DictionaryView<T>* result);
+  static napi_status ToJS(napi_env env,
+                          const DictionaryView<T>& value,
+                          napi_value* result);
+};
+
+template <typename T>
+class Converter<ColumnarSequence<T>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              ColumnarSequence<T>* result);
+  static napi_status ToJS(napi_env env,
+                          const ColumnarSequence<T>& value,
+                          napi_value* result);
+};
+
+template <typename K, typename V>
+class Converter<record<K, V>> {
+ public:
+  static napi_status ToNative(napi_env env,
+                              napi_value value,
+                              record<K, V>* result);
+  static napi_status ToJS(napi_env env,
+                          const record<K, V>& value,
+                          napi_value* result);
+};
+
+template <typename T>
+class Converter<Promise<T>> {
+ public:
+  static napi_status ToJS(napi_env env,
+                          const Promise<T>& value,
+                          napi_value* result);
+};
+
+// `Method<decltype(&Iface::op), &Iface::op>::Call` is a `napi_callback` which
+// converts its arguments to the parameter types of `Iface::op`, calls it on the
+// native instance wrapped by the receiver (or without a receiver if `op` is
+// static), and converts its return value back to JS. All converters are
+// deduced from the signature of `Iface::op` at compile time. An argument whose
+// bit is set in `optional_mask` is left default-constructed if it is
+// `undefined`.
+template <typename Fn, Fn fn, uint32_t optional_mask = 0>
+class Method {
+ public:
+  static napi_value Call(napi_env env, napi_callback_info info);
+};
+
+// `BatchMethod<decltype(&Iface::op), &Iface::op>::Call` is the `napi_callback`
+// bound as `opBatch` for an operation marked `[Batch]`. It calls `Iface::op`
+// once for each item of a batch and returns an array of the results, or
+// `undefined` if `op` returns `void`. The items are either an array of argument
+// arrays, as in `opBatch([[a0, b0], [a1, b1]])`, or, if all arguments are
+// numeric, one typed array per argument, as in `opBatch(as, bs)`, in which case
+// numeric results are returned in a `Float64Array`. The receiver is unwrapped
+// once per batch, and the native arguments are reused from one item to the
+// next, so that strings and sequences can reuse their storage.
+template <typename Fn, Fn fn, uint32_t optional_mask = 0>
+class BatchMethod {
+ public:
+  static napi_value Call(napi_env env, napi_callback_info info);
+};
+
+// `Getter<decltype(&Iface::attr), &Iface::attr>::Call` and
+// `Setter<decltype(&Iface::attr), &Iface::attr>::Call` are the accessors for
+// the attribute `attr` stored in the native instance wrapped by the receiver.
+// If `same_obj_idx` is not -1, the attribute is `[SameObject]` and the value
+// returned the first time is stored at that index in the `Wrapping<Iface>`.
+template <typename Member, Member member, int same_obj_idx = -1>
+class Getter {
+ public:
+  static napi_value Call(napi_env env, napi_callback_info info);
+};
+
+template <typename Member, Member member>
+class Setter {
+ public:
+  static napi_value Call(napi_env env, napi_callback_info info);
+};
+
+template <typename T>
+class Accessor {
+ public:
+  static napi_value Get(napi_env env, napi_callback_info info);
+  static napi_value Set(napi_env env, napi_callback_info info);
+};
+
 }  // end of namespace WebIdlNapi
 
 #include "webidl-napi-inl.h"